@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_BATCH_RUNNER_HPP
+#define SPACE_INVADERS_BATCH_RUNNER_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include <SpaceInvaders/HeadlessClient.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Summary of the results of many games
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct BatchSummary
+    {
+        unsigned int games = 0;        ///< Amount of games that were played
+        unsigned int gamesLost = 0;    ///< Amount of games that ended with a game over
+
+        double       meanScore = 0;    ///< Average score at the end of a game
+        unsigned int minScore = 0;     ///< Lowest score at the end of a game
+        unsigned int maxScore = 0;     ///< Highest score at the end of a game
+
+        double       meanLevel = 0;    ///< Average level that was reached
+        unsigned int minLevel = 0;     ///< Lowest level that was reached
+        unsigned int maxLevel = 0;     ///< Highest level that was reached
+
+        double       meanSurvival = 0; ///< Average game time in seconds before the game ended
+        double       minSurvival = 0;  ///< Shortest game time in seconds before the game ended
+        double       maxSurvival = 0;  ///< Longest game time in seconds before the game ended
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Plays many headless games at the same time on different threads
+    ///
+    /// Every game has its own controller, view and seed, so the games don't share any state and the
+    /// result of a game only depends on its seed. Consecutive seeds give statistically independent
+    /// streams of random numbers, because the seed is scrambled before it is used.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class BatchRunner
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor
+        ///
+        /// @param threadCount  Amount of threads that play games, 0 to use one thread per cpu core
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        BatchRunner(unsigned int threadCount = 0);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Play a number of games and wait until they have all ended
+        ///
+        /// @param games       Amount of games to play
+        /// @param firstSeed   Seed of the first game, the next games use the seeds that follow it
+        /// @param playerType  The way in which the player is controlled in every game
+        /// @param maxTicks    Maximum amount of updates in a single game
+        /// @param tickTime    Time that passes in the game during every update
+        ///
+        /// @return The result of every game, in the order of their seeds
+        ///
+        /// When a game throws an exception, the threads stop starting new games and the first exception is
+        /// thrown again from this function once all threads have finished.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        std::vector<GameResult> run(unsigned int games, std::uint64_t firstSeed, HeadlessClient::PlayerType playerType,
+                                    unsigned int maxTicks, const sf::Time& tickTime) const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the amount of threads that are used to play the games
+        ///
+        /// @return Amount of threads
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        unsigned int getThreadCount() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Calculate the statistics of a list of games
+        ///
+        /// @param results  Results that were returned by the run function
+        ///
+        /// @return The summary of the results
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static BatchSummary summarize(const std::vector<GameResult>& results);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        unsigned int m_threadCount;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_BATCH_RUNNER_HPP
@@ -28,6 +28,9 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <SpaceInvaders/Controller/Controller.hpp>
+#include <SpaceInvaders/Factory/LevelEntityFactory.hpp>
+#include <SpaceInvaders/InputRecording.hpp>
+#include <SpaceInvaders/Random.hpp>
 #include <SpaceInvaders/View/AbstractView.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -43,10 +46,33 @@ namespace Game
     public:
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        /// @brief Default constructor
+        /// @brief Constructor
+        ///
+        /// @param seed            Seed from which the random numbers of every level are derived
+        /// @param ticksPerSecond  How many times per second the game logic is updated.
+        ///                        When 0 is passed, the game logic is updated once every frame with the time
+        ///                        that passed since the previous frame.
+        ///
+        /// @param recordingFilename  When not empty, the keys that are pressed will be written to this file
+        ///                           when the game quits, so that the session can be replayed.
+        ///                           This requires a fixed amount of ticks per second.
+        ///
+        /// @param createFactory  Creates the factory for every level, the levels are loaded from the level
+        ///                       file when it is a nullptr
+        ///
+        /// @param renderThread  When true, the window is drawn on its own thread from snapshots that are
+        ///                      published after every tick, so slow drawing doesn't delay the game logic
+        ///
+        /// @param levelOptions  The command line options from which createFactory was made, they are stored in the
+        ///                      recording so that the replay can create the same factory
+        ///
+        /// With a fixed amount of ticks per second, the game behaves the same no matter how fast the frames
+        /// are drawn. The view will interpolate the position of the entities between two updates.
         ///
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        Client();
+        Client(std::uint64_t seed, unsigned int ticksPerSecond = TICKS_PER_SECOND, const std::string& recordingFilename = "",
+               EntityFactoryCreator createFactory = nullptr, bool renderThread = false,
+               const std::vector<std::string>& levelOptions = {});
 
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -62,9 +88,15 @@ namespace Game
     private:
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        // Load the next level of the game
+        // Update the game logic in steps of m_tickTime for the time that has passed
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void updateFixedTicks(const sf::Time& elapsedTime);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Load the next level of the game, the view is reused
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        void loadNextLevel(const Event& event);
+        void loadNextLevel();
 
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -74,15 +106,27 @@ namespace Game
 
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        // Callback function for when the game is lost
+        // Start over at the first level after the game was lost
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        void gameOver(const Event& event);
+        void gameOver();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Write the recorded inputs to the file
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void saveRecording();
 
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
     private:
         unsigned int m_difficulty = 0;
 
+        // Every level gets its own stream that is split off from this one
+        Random m_random;
+
+        // Creates the factory of every level, by default it copies a factory that loaded the level file
+        EntityFactoryCreator m_createFactory;
+
         GameState m_gameState = GameState::MainMenu;
 
         std::unique_ptr<View::AbstractView> m_view;
@@ -91,6 +135,19 @@ namespace Game
         unsigned int m_score = 0;
 
         bool m_running = true;
+
+        // The level can't be changed while the controller is still busy, so it is done after updating
+        bool m_levelComplete = false;
+        bool m_gameOver = false;
+
+        sf::Time m_tickTime;
+        sf::Time m_accumulatedTime;
+
+        // Only used when recording, the inputs are stored together with the tick in which they occurred
+        std::unique_ptr<InputRecording> m_recording;
+        std::string   m_recordingFilename;
+        std::uint32_t m_tick = 0;
+        std::uint64_t m_totalScore = 0;
     };
 }
 
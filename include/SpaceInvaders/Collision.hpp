@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_COLLISION_HPP
+#define SPACE_INVADERS_COLLISION_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SpaceInvaders/Global.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Rectangles stored with one array per side, so that the collision kernel can test several of
+    ///        them with a single instruction
+    ///
+    /// The arrays are always padded to a multiple of the batch size with rectangles that overlap nothing.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class PackedRects
+    {
+    public:
+
+        /// @brief The amount of rectangles that the collision kernel tests at once
+        static const std::size_t BATCH_SIZE = 8;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Remove all rectangles, the memory is kept to be reused
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void clear();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Add a rectangle at the end of the arrays
+        ///
+        /// @param rect  The rectangle to add
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void push(const FloatRect& rect);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Returns the amount of rectangles, without the padding
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        std::size_t size() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Returns the arrays with the sides of the rectangles, their size is a multiple of BATCH_SIZE
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        const float* getLefts() const;
+        const float* getTops() const;
+        const float* getRights() const;
+        const float* getBottoms() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        std::vector<float> m_lefts;
+        std::vector<float> m_tops;
+        std::vector<float> m_rights;
+        std::vector<float> m_bottoms;
+
+        std::size_t m_size = 0;
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Overlap tests between axis-aligned rectangles
+    ///
+    /// Two rectangles overlap when they share some area, touching sides don't count. The batch test uses
+    /// AVX when the compiler targets it (e.g. with -mavx), SSE on other x86 processors and plain code on
+    /// everything else. All of them give exactly the same results.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    namespace Collision
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Check if two rectangles overlap
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        inline bool overlaps(const FloatRect& first, const FloatRect& second)
+        {
+            return (first.left < second.left + second.width) && (second.left < first.left + first.width)
+                && (first.top < second.top + second.height) && (second.top < first.top + first.height);
+        }
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Test a rectangle against a batch of packed rectangles
+        ///
+        /// @param rect   The rectangle to test
+        /// @param rects  The packed rectangles
+        /// @param first  Index of the first rectangle of the batch, a multiple of PackedRects::BATCH_SIZE
+        ///
+        /// @return Bitmask in which bit i is set when the rectangle overlaps rectangle first + i
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        unsigned int overlapBatch(const FloatRect& rect, const PackedRects& rects, std::size_t first);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Call a function for every packed rectangle that overlaps with a rectangle
+        ///
+        /// @param rect      The rectangle to test
+        /// @param rects     The packed rectangles
+        /// @param function  Function that is called with the index of every overlapping rectangle,
+        ///                  in increasing order
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        template <typename Function>
+        void forEachOverlap(const FloatRect& rect, const PackedRects& rects, Function function)
+        {
+            for (std::size_t first = 0; first < rects.size(); first += PackedRects::BATCH_SIZE)
+            {
+                // Most batches don't overlap at all, so only the hits are looked at one by one
+                for (unsigned int mask = overlapBatch(rect, rects, first), bit = 0; mask != 0; mask >>= 1, ++bit)
+                {
+                    if (mask & 1)
+                        function(first + bit);
+                }
+            }
+        }
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Returns the name of the instructions used by overlapBatch ("AVX", "SSE" or "scalar")
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        const char* getInstructionSet();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_COLLISION_HPP
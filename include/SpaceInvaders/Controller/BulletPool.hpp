@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_BULLET_POOL_HPP
+#define SPACE_INVADERS_BULLET_POOL_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SpaceInvaders/Model/Entities.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace View
+    {
+        class AbstractView;
+    }
+
+    namespace Controller
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Pool of bullets that are reused instead of being created every time a gun is fired
+        ///
+        /// The bullets are only created once, added to the view and the entity store, and then hidden.
+        /// Firing a gun shows a hidden bullet again and removing a bullet hides it. The hidden bullets are
+        /// kept in a separate list for every image and size, so firing only has to take the last one.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class BulletPool
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Constructor to initialize the pool
+            ///
+            /// @param view   Pointer to the view, needed for finishing the creation of the bullets
+            /// @param store  Store in which the data of the bullets will be kept
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            BulletPool(View::AbstractView* view, Model::EntityStore& store);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Create bullets up front, so that firing the gun won't have to create them
+            ///
+            /// @param gun    The gun that will fire the bullets
+            /// @param count  Amount of bullets to create
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void reserve(const Model::Gun& gun, unsigned int count);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Take a bullet out of the pool
+            ///
+            /// @param gun       The gun that fires the bullet, it determines the image, size and speed
+            /// @param position  Position of the bullet
+            ///
+            /// @return The bullet, which is visible again
+            ///
+            /// A new bullet is only created when there is no hidden bullet with the same image and size.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            BulletPtr acquire(const Model::Gun& gun, const Vector2f& position);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Hide the bullet and put it back in the pool
+            ///
+            /// @param bullet  The bullet that is no longer needed
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void release(const BulletPtr& bullet);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the amount of bullets that were created by the pool
+            ///
+            /// @return Amount of visible and hidden bullets
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            std::size_t getBulletCount() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            // Hidden bullets that all have the same image and size
+            struct FreeList
+            {
+                std::string            filename;
+                Vector2f               size;
+                std::vector<BulletPtr> bullets;
+            };
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Find the list of hidden bullets with the given image and size, it is created when needed.
+            // There are only a few kinds of bullets, so this doesn't have to be more than a linear search.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            FreeList& getFreeList(const std::string& filename, const Vector2f& size);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Create a new hidden bullet and add it to the free bullets
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void createBullet(const Model::Gun& gun, FreeList& freeList);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            View::AbstractView* m_view;
+            Model::EntityStore& m_store;
+
+            std::vector<BulletPtr> m_bullets;
+            std::vector<FreeList>  m_freeLists;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_BULLET_POOL_HPP
@@ -27,6 +27,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <SpaceInvaders/Controller/BulletPool.hpp>
+#include <SpaceInvaders/Controller/DestroyQueue.hpp>
 #include <SpaceInvaders/Controller/EnemyController.hpp>
 #include <SpaceInvaders/Controller/PlayerController.hpp>
 #include <SpaceInvaders/Controller/WallController.hpp>
@@ -59,12 +61,17 @@ namespace Game
             ///
             /// @param view       Pointer to the view
             /// @param difficulty The difficulty of this level
+            /// @param random     Stream of random numbers for this level, the level plays out the same when
+            ///                   the same stream is used with the same input
+            /// @param factory    Factory that creates the entities of the level, a DebugEntityFactory is used
+            ///                   when it is a nullptr
             ///
-            /// The parameters passes to this constructor are only needed for instantiating the entities.
+            /// The view and difficulty are only needed for instantiating the entities.
             /// They aren't required for the real work that the controller does.
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            Controller(View::AbstractView* view, unsigned int difficulty);
+            Controller(View::AbstractView* view, unsigned int difficulty, Random random,
+                       std::unique_ptr<AbstractEntityFactory> factory = nullptr);
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -76,6 +83,15 @@ namespace Game
             void update(const sf::Time& elapsedTime);
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the store which contains the data of all entities in this level
+            ///
+            /// @return Store with the positions, sizes, speeds, types and alive flags of the entities
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const Model::EntityStore& getEntityStore() const;
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
         private:
 
@@ -85,12 +101,30 @@ namespace Game
             void updateBullets(const sf::Time& elapsedTime);
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// Create the bullets that the factory wants to be flying at the start of the level.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void createSpawnedBullets(unsigned int difficulty);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// Give all bullets back to the pool.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void removeAllBullets();
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// Called when the lives of the player changes.
             ////////////////////////////////////////////////////////////////////////////////////////////////
             void livesChanged(const Event& event);
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// Called at the end of the tick in which the player was hit.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void playerHit();
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// Called when a powerup gets activated.
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -109,12 +143,6 @@ namespace Game
             void createBullet(const Event& event);
 
 
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// Called when an enemy has moved.
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-            void enemyMoved(const Event& event);
-
-
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// Called when the score has changed.
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -129,17 +157,28 @@ namespace Game
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
         private:
-            unsigned int m_difficulty;
-
             View::AbstractView *const m_view;
             std::unique_ptr<AbstractEntityFactory> m_factory;
 
+            // The store has to be destroyed after the subcontrollers, which hold the entities
+            Model::EntityStore m_entityStore;
+
             PlayerController  m_playerController;
             EnemyController   m_enemyController;
             WallController    m_wallController;
+
+            // The powerups change the modifiers of the subcontrollers above, so they have to be destroyed first
             PowerupController m_powerupController;
 
+            // The pool owns all bullets, the list only contains the ones that are flying
+            BulletPool             m_bulletPool;
             std::vector<BulletPtr> m_bullets;
+            DestroyQueue           m_bulletQueue;
+
+            bool m_playerHit = false;
+
+            // The position where the player starts and returns to after being hit
+            Vector2f m_playerSpawnPosition;
 
             float m_lowestEnemyPosition = 0;
         };
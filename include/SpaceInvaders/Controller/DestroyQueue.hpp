@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_DESTROY_QUEUE_HPP
+#define SPACE_INVADERS_DESTROY_QUEUE_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <SpaceInvaders/Model/Entities.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace Controller
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief List of entities that have to be removed at the end of the tick
+        ///
+        /// Entities that are hit during the tick are not removed right away, because the lists that they
+        /// are part of might still be used in a loop. When the queue is flushed, all queued entities are
+        /// removed from their list at once with swap-and-pop, so the order of the list is not kept.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class DestroyQueue
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add an entity to the queue
+            ///
+            /// @param entity  The entity that has to be removed at the end of the tick
+            ///
+            /// Adding the same entity more than once has the same effect as adding it once.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void push(Model::Entity* entity);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns whether there are entities in the queue
+            ///
+            /// @return True when nothing has to be removed
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            bool isEmpty() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove the queued entities from a list and empty the queue
+            ///
+            /// @param entities  The list that contains the queued entities
+            /// @param remove    Function that is called with every entity that was removed from the list
+            ///                  (e.g. to destroy it). It may not change the list.
+            ///
+            /// @return Amount of entities that were removed from the list
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            template <typename T, typename Function>
+            std::size_t flush(std::vector<std::shared_ptr<T>>& entities, Function remove);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Empty the queue without removing anything
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void clear();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            std::vector<Model::Entity*> m_entities;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        template <typename T, typename Function>
+        std::size_t DestroyQueue::flush(std::vector<std::shared_ptr<T>>& entities, Function remove)
+        {
+            if (m_entities.empty())
+                return 0;
+
+            // Sorting allows checking every element of the list with a binary search
+            std::sort(m_entities.begin(), m_entities.end());
+            m_entities.erase(std::unique(m_entities.begin(), m_entities.end()), m_entities.end());
+
+            std::size_t removed = 0;
+            for (std::size_t i = 0; i < entities.size();)
+            {
+                if (std::binary_search(m_entities.begin(), m_entities.end(), static_cast<Model::Entity*>(entities[i].get())))
+                {
+                    // The list might be the only owner, so the entity is kept alive until it has been handled
+                    std::shared_ptr<T> entity = std::move(entities[i]);
+                    entities[i] = std::move(entities.back());
+                    entities.pop_back();
+
+                    remove(entity);
+                    removed++;
+                }
+                else
+                    i++;
+            }
+
+            m_entities.clear();
+            return removed;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_DESTROY_QUEUE_HPP
@@ -27,9 +27,14 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#include <random>
-#include <chrono>
+#include <unordered_map>
+#include <SpaceInvaders/Collision.hpp>
 #include <SpaceInvaders/Observable.hpp>
+#include <SpaceInvaders/Random.hpp>
+#include <SpaceInvaders/Controller/SpatialGrid.hpp>
+#include <SpaceInvaders/Controller/DestroyQueue.hpp>
+#include <SpaceInvaders/Controller/ModifierStack.hpp>
+#include <SpaceInvaders/Model/Formation.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -45,6 +50,9 @@ namespace Game
         ////////////////////////////////////////////////////////////////////////////////////////////////////
         /// @brief Class that has control over the enemies
         ///
+        /// The enemies are part of a single formation. Only the formation is moved, which doesn't depend
+        /// on the amount of enemies.
+        ///
         ////////////////////////////////////////////////////////////////////////////////////////////////////
         class EnemyController : public Observable
         {
@@ -55,9 +63,11 @@ namespace Game
             ///
             /// @param enemies List of enemies which the controller will control
             /// @param view    Pointer to the view, only needed for finishing the creation of the enemies
+            /// @param store   Store in which the data of the enemies will be kept
+            /// @param random  Stream of random numbers that decide when the enemies fire and which powerups drop
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            EnemyController(AttackingEntityList enemies, View::AbstractView* view);
+            EnemyController(AttackingEntityList enemies, View::AbstractView* view, Model::EntityStore& store, Random random);
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -72,13 +82,24 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Check if a bullet has hit one of the enemies
             ///
-            /// @param entity  The bullet to check against the enemies
+            /// @param bounds  The bounds of the bullet to check against the enemies
+            ///
+            /// @return True when one of the enemies overlapped and will be destroyed.
+            ///         False when none of the enemies overlapped with the bullet.
             ///
-            /// @return True when one of the enemies overlapped and is now destroyed.
-            ///         False when none of the enemies overlapped with the bullet entity.
+            /// The enemies that were hit are only destroyed when calling removeDestroyed.
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            bool checkCollision(EntityPtr entity);
+            bool checkCollision(const FloatRect& bounds);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Destroy the enemies that were hit since the last call to this function
+            ///
+            /// @return Amount of enemies that were destroyed
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            std::size_t removeDestroyed();
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -90,15 +111,85 @@ namespace Game
             AttackingEntityList& getEnemies();
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the formation in which the enemies are moving
+            ///
+            /// @return Formation of the enemies
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const Model::Formation& getFormation() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the modifiers of the speed of the formation
+            ///
+            /// @return Stack with the factors that are applied on the speed of all enemies at once
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            ModifierStack& getSpeedModifiers();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove all enemies
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void clear();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Divide the enemies in columns, based on their position inside the formation
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void createColumns();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Remove a destroyed enemy from its column, the enemy above it can then fire
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void removeFromColumn(Model::AttackingEntity* enemy);
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
         private:
+
+            // The enemies in a column are sorted from top to bottom, only the last one can fire
+            struct Column
+            {
+                std::vector<Model::AttackingEntity*> enemies;
+                std::size_t shooterIndex;
+            };
+
+            // The formation has to be destroyed after the enemies that are part of it
+            Model::Formation m_formation;
+
             AttackingEntityList m_enemies;
+            const Model::EntityStore& m_store;
+
+            SpatialGrid m_grid;
+            std::vector<EntityId> m_candidates;
+            PackedRects m_candidateBounds; // Bounds of the candidates, in the same order
+            DestroyQueue m_destroyQueue;
+
+            std::vector<Column> m_columns;
+            std::vector<unsigned int> m_shooterColumns; // Columns that still contain enemies
+            std::unordered_map<Model::Entity*, unsigned int> m_enemyColumns;
+
             bool  m_movingDown = false;
             float m_movingDownDistance = 0;
 
             float m_fireChance = 0;
 
-            std::default_random_engine generator = std::default_random_engine(std::chrono::system_clock::now().time_since_epoch().count());
+            // Game time since the start of the level, used for the cooldown of the guns
+            sf::Time m_time;
+
+            // Powerups slow down the formation as a whole instead of every enemy
+            ModifierStack m_speedModifiers;
+
+            // Separate streams, so that killing an enemy doesn't change when the next bullet is fired
+            Random m_fireRandom;
+            Random m_powerupRandom;
         };
     }
 }
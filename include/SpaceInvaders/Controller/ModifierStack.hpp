@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_MODIFIER_STACK_HPP
+#define SPACE_INVADERS_MODIFIER_STACK_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace Controller
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Factors that change a property of a whole group of entities
+        ///
+        /// A stack belongs to a group, like the enemy formation or the player, and the controller of the
+        /// group multiplies the property with the factor of the stack whenever it reads it. Activating a
+        /// powerup on a group therefore doesn't depend on how many entities the group contains.
+        ///
+        /// The factor is calculated again from the remaining modifiers when one is removed, so stacked
+        /// modifiers can be removed in any order without rounding errors building up.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class ModifierStack
+        {
+        public:
+
+            typedef unsigned int ModifierId;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add a modifier to the stack
+            ///
+            /// @param factor  The factor with which the property will be multiplied
+            ///
+            /// @return Id of the modifier, which has to be passed to remove
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            ModifierId push(float factor);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove a modifier from the stack
+            ///
+            /// @param id  Id that was returned when the modifier was added
+            ///
+            /// @return True when the modifier was removed, false when it wasn't part of the stack
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            bool remove(ModifierId id);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the product of all modifiers on the stack
+            ///
+            /// @return Factor with which the property has to be multiplied, 1 when the stack is empty
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            float getFactor() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            struct Modifier
+            {
+                ModifierId id;
+                float      factor;
+            };
+
+            // The modifiers in the order in which they were added
+            std::vector<Modifier> m_modifiers;
+
+            ModifierId m_nextId = 0;
+            float      m_factor = 1;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_MODIFIER_STACK_HPP
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <SpaceInvaders/Observable.hpp>
+#include <SpaceInvaders/Controller/ModifierStack.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -53,9 +54,19 @@ namespace Game
             ///
             /// @param player Player entity which the controller will control
             /// @param view   Pointer to the view, only needed for finishing the creation of the player
+            /// @param store  Store in which the data of the player will be kept
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            PlayerController(AttackingEntityPtr player, View::AbstractView* view);
+            PlayerController(AttackingEntityPtr player, View::AbstractView* view, Model::EntityStore& store);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Destructor that stops listening to the key events of the view
+            ///
+            /// The view has to outlive the player controller.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            ~PlayerController();
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -70,13 +81,13 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Check if a bullet has hit the player
             ///
-            /// @param entity  The bullet to check against the player
+            /// @param bounds  The bounds of the bullet to check against the player
             ///
             /// @return True when the player overlapped and is now destroyed.
-            ///         False when the player did not overlap with the bullet entity.
+            ///         False when the player did not overlap with the bullet.
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            bool checkCollision(EntityPtr entity);
+            bool checkCollision(const FloatRect& bounds);
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -88,6 +99,24 @@ namespace Game
             AttackingEntityPtr& getPlayer();
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the modifiers of the speed of the player
+            ///
+            /// @return Stack with the factors that are applied on the speed of the player when it moves
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            ModifierStack& getSpeedModifiers();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the modifiers of the fire rate of the player
+            ///
+            /// @return Stack with the factors that are applied on the fire rate of the gun of the player
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            ModifierStack& getFireRateModifiers();
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
         private:
 
@@ -100,9 +129,20 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
         private:
             AttackingEntityPtr m_player;
+
+            View::AbstractView* m_view;
+            std::vector<ObserverHandle> m_viewObservers;
+
             bool m_moveLeftKeyDown = false;
             bool m_moveRightKeyDown = false;
             bool m_fireKeyDown = false;
+
+            // Game time since the start of the level, used for the cooldown of the gun
+            sf::Time m_time;
+
+            // Powerups change these instead of the player itself
+            ModifierStack m_speedModifiers;
+            ModifierStack m_fireRateModifiers;
         };
     }
 }
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <SpaceInvaders/Global.hpp>
+#include <SpaceInvaders/Controller/ModifierStack.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -46,11 +47,10 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Constructor to initialize the powerup
             ///
-            /// @param entity   The entity on which the powerup will work
             /// @param duration The duration of the powerup
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            Powerup(EntityPtr entity, const sf::Time& duration);
+            Powerup(const sf::Time& duration);
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -74,73 +74,43 @@ namespace Game
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
         protected:
-            EntityPtr m_entity;
-            sf::Time  m_duration;
-            sf::Time  m_elapsed;
+            sf::Time m_duration;
+            sf::Time m_elapsed;
         };
 
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        /// @brief Powerup that changes the speed of an entity
+        /// @brief Powerup that changes a property of a group of entities, like their speed or fire rate
         ///
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        class SpeedChangePowerup : public Powerup
+        class ModifierPowerup : public Powerup
         {
         public:
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Constructor to initialize the powerup
             ///
-            /// @param entity      The entity on which the powerup will work
-            /// @param duration    The duration of the powerup
-            /// @param speedFactor The factor with which the speed will be multiplied
+            /// @param modifiers The stack of the group and property on which the powerup will work
+            /// @param duration  The duration of the powerup
+            /// @param factor    The factor with which the property will be multiplied
             ///
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-            SpeedChangePowerup(AttackingEntityPtr entity, const sf::Time& duration, float speedFactor);
-
-
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// @brief Destructor
-            ///
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-            ~SpeedChangePowerup();
-
-
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-        private:
-            float m_speedFactor;
-        };
-
-
-        ////////////////////////////////////////////////////////////////////////////////////////////////////
-        /// @brief Powerup that changes the fire rate of the gun of an entity
-        ///
-        ////////////////////////////////////////////////////////////////////////////////////////////////////
-        class FireRatePowerup : public Powerup
-        {
-        public:
-
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// @brief Constructor to initialize the powerup
-            ///
-            /// @param entity         The entity on which the powerup will work
-            /// @param duration       The duration of the powerup
-            /// @param fireRateFactor The factor with which the fire rate will be multiplied
+            /// The stack has to outlive the powerup.
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            FireRatePowerup(AttackingEntityPtr entity, const sf::Time& duration, float fireRateFactor);
+            ModifierPowerup(ModifierStack& modifiers, const sf::Time& duration, float factor);
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Destructor
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            ~FireRatePowerup();
+            ~ModifierPowerup();
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
         private:
-            float m_fireRateFactor;
+            ModifierStack&            m_modifiers;
+            ModifierStack::ModifierId m_modifierId;
         };
     }
 }
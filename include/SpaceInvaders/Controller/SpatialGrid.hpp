@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_SPATIAL_GRID_HPP
+#define SPACE_INVADERS_SPATIAL_GRID_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <unordered_map>
+#include <SpaceInvaders/Global.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace Controller
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Uniform grid over the screen to quickly find the entities near a certain area
+        ///
+        /// Every entity is stored in all the cells that it overlaps. Entities outside the screen are stored
+        /// in the cells at the border of the screen. The grid only returns candidates, the caller still has
+        /// to check if the entities really overlap.
+        ///
+        /// The entities are identified by their id in the entity store, so that the caller can read the
+        /// bounds of the candidates from the store without following a pointer to every entity.
+        ///
+        /// Entities that are part of a formation are stored with their position relative to the formation,
+        /// so the grid doesn't change when the formation moves. The area to look in should then also be
+        /// relative to the formation.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class SpatialGrid
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Constructor to initialize the grid
+            ///
+            /// @param cellSize  Width and height of a single cell
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            SpatialGrid(float cellSize = 32);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add an entity to the grid
+            ///
+            /// @param id      The id of the entity in the entity store
+            /// @param bounds  The area that the entity occupies
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void insert(EntityId id, const FloatRect& bounds);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove an entity from the grid
+            ///
+            /// @param id  The id of the entity to remove
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void remove(EntityId id);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Update the cells of an entity after it has moved
+            ///
+            /// @param id      The id of the entity that has moved
+            /// @param bounds  The area that the entity now occupies
+            ///
+            /// Nothing happens when the entity still overlaps the same cells or when it isn't in the grid.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void move(EntityId id, const FloatRect& bounds);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove all entities from the grid
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void clear();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Find the entities that might overlap with an area
+            ///
+            /// @param area        The area to look in
+            /// @param candidates  List that will be filled with the ids of the entities in the cells overlapping
+            ///                    the area. Every entity is only added once.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void query(const FloatRect& area, std::vector<EntityId>& candidates) const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            struct CellRange
+            {
+                unsigned int left;
+                unsigned int top;
+                unsigned int right;
+                unsigned int bottom;
+            };
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Returns the cells that are overlapped by the given area
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            CellRange getCellRange(const FloatRect& area) const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Add or remove the entity in all cells of the range
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void addToCells(EntityId id, const CellRange& range);
+            void removeFromCells(EntityId id, const CellRange& range);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            float m_cellSize;
+            unsigned int m_columns;
+            unsigned int m_rows;
+
+            std::vector<std::vector<EntityId>> m_cells;
+            std::unordered_map<EntityId, CellRange> m_entityCells;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_SPATIAL_GRID_HPP
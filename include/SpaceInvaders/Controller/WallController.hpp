@@ -27,7 +27,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <SpaceInvaders/Collision.hpp>
 #include <SpaceInvaders/Observable.hpp>
+#include <SpaceInvaders/Controller/SpatialGrid.hpp>
+#include <SpaceInvaders/Controller/DestroyQueue.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -51,23 +54,37 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Constructor to initialize the controller
             ///
-            /// @param walls List of walls which the controller will control
-            /// @param view  Pointer to the view, only needed for finishing the creation of the walls
+            /// @param walls   List of walls which the controller will control
+            /// @param bunkers List of bunkers which the controller will control
+            /// @param view    Pointer to the view, only needed for finishing the creation of the walls
+            /// @param store   Store in which the data of the walls will be kept
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            WallController(EntityList walls, View::AbstractView* view);
+            WallController(EntityList walls, BunkerList bunkers, View::AbstractView* view, Model::EntityStore& store);
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// @brief Check if a bullet has hit one of the enemies
+            /// @brief Check if a bullet has hit one of the walls or bunkers
             ///
-            /// @param entity  The bullet to check against the enemies
+            /// @param bounds  The bounds of the bullet to check against the walls and bunkers
             ///
-            /// @return True when one of the enemies overlapped and is now destroyed.
-            ///         False when none of the enemies overlapped with the bullet entity.
+            /// @return True when one of the walls or bunkers was hit.
+            ///         False when none of them overlapped with the bullet.
+            ///
+            /// The walls that were hit are only destroyed when calling removeDestroyed.
+            /// Bunkers lose the cells that were hit immediately, they are never destroyed.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            bool checkCollision(const FloatRect& bounds);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Destroy the walls that were hit since the last call to this function
+            ///
+            /// @return Amount of walls that were destroyed
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            bool checkCollision(EntityPtr entity);
+            std::size_t removeDestroyed();
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -79,9 +96,35 @@ namespace Game
             EntityList& getWalls();
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the bunkers
+            ///
+            /// @return List of bunkers
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            BunkerList& getBunkers();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove all walls and bunkers
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void clear();
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
         private:
             EntityList m_walls;
+            const Model::EntityStore& m_store;
+
+            SpatialGrid m_grid;
+            std::vector<EntityId> m_candidates;
+            PackedRects m_candidateBounds; // Bounds of the candidates, in the same order
+            DestroyQueue m_destroyQueue;
+
+            // Bunkers don't move, so their bounds are only packed once
+            BunkerList  m_bunkers;
+            PackedRects m_bunkerBounds;
         };
     }
 }
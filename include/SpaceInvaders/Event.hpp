@@ -63,7 +63,11 @@ namespace Game
             LivesChanged,         ///< The lives of the player have changed
             GameStateChanged,     ///< The current game state has changed
             PowerupActivated,     ///< A powerup has been activated
-            PowerupDeactivated    ///< A powerup has stopped working
+            PowerupDeactivated,   ///< A powerup has stopped working
+            VisibilityChanged,    ///< An entity has been hidden or shown again
+            BunkerDamaged,        ///< Cells of a bunker have been shot away
+
+            Count                 ///< The amount of event types, this is not a real event
         };
 
         Type type;             ///< The type of the event
@@ -77,6 +81,7 @@ namespace Game
             unsigned int lives;      ///< New amount of lives when type is LivesChanged
             GameState    gameState;  ///< The new game state when type is GameStateChanged
             PowerupType  powerup;    ///< The type of the powerup when type is PowerupActivated
+            bool         visible;    ///< Whether the entity is now visible when type is VisibilityChanged
         };
 
 
@@ -29,11 +29,25 @@
 
 #include <SpaceInvaders/Model/Entities.hpp>
 #include <SpaceInvaders/Model/Gun.hpp>
+#include <functional>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace Game
 {
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief A bullet that is already flying when the level starts
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct BulletSpawn
+    {
+        GunType  gun;      ///< Type of the gun that fired the bullet
+        Vector2f position; ///< Position of the bullet
+    };
+
+    typedef std::vector<BulletSpawn> BulletSpawnList;
+
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// @brief Base class for the abstract factory pattern
     ///
@@ -100,7 +114,57 @@ namespace Game
         ///
         ////////////////////////////////////////////////////////////////////////////////////////////////////
         virtual Model::Gun createGun(unsigned int difficulty, GunType type) = 0;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the bullets that are already flying when the level starts
+        ///
+        /// @param difficulty  The difficulty
+        ///
+        /// The bullets are fired by a gun created with createGun. By default no bullets are created.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        virtual BulletSpawnList createBullets(unsigned int difficulty)
+        {
+            (void)difficulty;
+            return BulletSpawnList();
+        }
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the bunkers, the defence walls that are shot away piece by piece
+        ///
+        /// @param difficulty  The difficulty
+        ///
+        /// Bunkers are used together with the walls from createWalls. By default no bunkers are created.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        virtual BunkerList createBunkers(unsigned int difficulty)
+        {
+            (void)difficulty;
+            return BunkerList();
+        }
     };
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Function that creates a new factory, the clients call it once for every level
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    typedef std::function<std::unique_ptr<AbstractEntityFactory>()> EntityFactoryCreator;
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Returns a function that creates copies of the given factory
+    ///
+    /// @param prototype  The factory that will be copied every time the function is called
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename Factory>
+    EntityFactoryCreator makeFactoryCreator(const Factory& prototype)
+    {
+        return [prototype]() { return std::unique_ptr<AbstractEntityFactory>{new Factory{prototype}}; };
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
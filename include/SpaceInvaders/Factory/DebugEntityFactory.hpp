@@ -55,10 +55,22 @@ namespace Game
         /// @param difficulty  The difficulty of the level.
         ///                    In this factory the difficulty has no influence on the walls.
         ///
+        /// This factory has no loose walls, the defence consists of bunkers.
+        ///
         ////////////////////////////////////////////////////////////////////////////////////////////////////
         EntityList createWalls(unsigned int difficulty);
 
 
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the bunkers
+        ///
+        /// @param difficulty  The difficulty of the level.
+        ///                    In this factory the difficulty has no influence on the bunkers.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        BunkerList createBunkers(unsigned int difficulty);
+
+
         ////////////////////////////////////////////////////////////////////////////////////////////////////
         /// @brief Create the player
         ///
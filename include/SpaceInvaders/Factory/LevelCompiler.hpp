@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_LEVEL_COMPILER_HPP
+#define SPACE_INVADERS_LEVEL_COMPILER_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <istream>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Turns the text description of the levels into the binary format read by LevelEntityFactory
+    ///
+    /// Every line of the text contains a keyword followed by its values, separated by whitespace.
+    /// Empty lines and lines starting with '#' are ignored. The following lines are supported:
+    ///
+    ///   gun <name> <bullet image> <bullet width> <bullet height> <speed> <speed per level>
+    ///       <cooldown ms> <cooldown per level> <fire chance> <fire chance per level>
+    ///   player <image> <gun> <x> <y> <width> <height> <speed> <speed per level> <lives>
+    ///   level
+    ///   enemies <image> <gun> <x> <y> <columns> <rows> <spacing x> <spacing y> <width> <height>
+    ///           <speed> <speed per level> <points> <points per level>
+    ///   walls <image> <x> <y> <columns> <rows> <width> <height>
+    ///   bunker <image> <x> <y> <width> <height> <columns> <rows> <gap columns> <gap rows>
+    ///   end
+    ///
+    /// Guns have to be defined before they are used. The enemies, walls and bunker lines are only allowed
+    /// between level and end. Enemies and walls place a grid of entities in the level, a bunker is a single
+    /// entity made of columns x rows cells with an opening at the bottom. Every level needs at least one enemy.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class LevelCompiler
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Compile the text description of the levels
+        ///
+        /// @param source  Stream from which the text is read
+        ///
+        /// @return Contents of the binary level file
+        ///
+        /// @exception std::runtime_error when the text contains an error, the message contains the line number
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static std::vector<char> compile(std::istream& source);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Compile a text file to a binary level file
+        ///
+        /// @param sourceFilename  Filename of the text description of the levels
+        /// @param outputFilename  Filename of the binary level file to write
+        ///
+        /// @exception std::runtime_error when a file can't be read or written, or the text contains an error
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static void compileFile(const std::string& sourceFilename, const std::string& outputFilename);
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_LEVEL_COMPILER_HPP
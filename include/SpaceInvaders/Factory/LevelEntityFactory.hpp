@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_LEVEL_ENTITY_FACTORY_HPP
+#define SPACE_INVADERS_LEVEL_ENTITY_FACTORY_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SpaceInvaders/Factory/AbstractEntityFactory.hpp>
+#include <SpaceInvaders/Factory/LevelFormat.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Concrete factory in the abstract factory pattern, which creates the entities from a level file
+    ///
+    /// The level file is created by LevelCompiler. It is mapped into memory and checked once when loading,
+    /// after that the entities are created directly from the mapped tables. Copies of the factory share the
+    /// mapped file, so a client can load the file once and give a copy to the controller of every level.
+    ///
+    /// When the difficulty is higher than the amount of levels in the file, the last level is repeated.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class LevelEntityFactory final : public AbstractEntityFactory
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Load a level file
+        ///
+        /// @param filename  Filename of the binary level file
+        ///
+        /// @exception std::runtime_error when the file can't be read or isn't a valid level file
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        LevelEntityFactory(const std::string& filename);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Returns the amount of levels in the file
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        unsigned int getLevelCount() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the enemies
+        ///
+        /// @param difficulty  The difficulty of the level, used as the level number
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        AttackingEntityList createEnemies(unsigned int difficulty);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the walls
+        ///
+        /// @param difficulty  The difficulty of the level, used as the level number
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        EntityList createWalls(unsigned int difficulty);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the bunkers
+        ///
+        /// @param difficulty  The difficulty of the level, used as the level number
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        BunkerList createBunkers(unsigned int difficulty);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the player
+        ///
+        /// @param difficulty  The difficulty of the level.
+        ///                    This will influence the moving speed, bullet fire rate and bullet speed.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        AttackingEntityPtr createPlayer(unsigned int difficulty);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create a gun which can be attached to an entity
+        ///
+        /// @param difficulty  The difficulty of the level.
+        ///                    This will influence the bullet fire rate and bullet speed.
+        /// @param type        Type of the gun to create, the gun with the same name in the file is used
+        ///
+        /// @exception std::runtime_error when the file doesn't contain a gun with the name of the type
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        Model::Gun createGun(unsigned int difficulty, GunType type);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+
+        // Returns the string at the given offset in the string table
+        const char* getString(std::uint32_t offset) const;
+
+        // Returns the level that is played at the given difficulty
+        const LevelFormat::Level& getLevel(unsigned int difficulty) const;
+
+        // Creates the gun from the record at the given index in the gun table
+        Model::Gun createGunFromTable(unsigned int difficulty, std::uint32_t gun) const;
+
+        // Returns the table at the given offset in the mapped file
+        template <typename T>
+        const T* getTable(std::uint32_t offset) const
+        {
+            return reinterpret_cast<const T*>(m_file.get() + offset);
+        }
+
+        // The mapped file, which is unmapped when the last copy of the factory is destroyed
+        std::shared_ptr<const char> m_file;
+
+        const LevelFormat::Header* m_header;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_LEVEL_ENTITY_FACTORY_HPP
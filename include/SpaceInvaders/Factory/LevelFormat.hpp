@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_LEVEL_FORMAT_HPP
+#define SPACE_INVADERS_LEVEL_FORMAT_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Layout of the binary level files that are written by LevelCompiler and read by LevelEntityFactory
+    ///
+    /// The file starts with the header, followed by the tables that the header points to. All fields are
+    /// 4 bytes in size and stored in little endian, so the tables can be used directly from the mapped file
+    /// without parsing them. Strings are stored as offsets in the string table, which contains null-terminated
+    /// strings.
+    ///
+    /// Values that depend on the difficulty are stored as a base value and an increase per level:
+    /// value = base + (perLevel * difficulty).
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    namespace LevelFormat
+    {
+        const char         MAGIC[4] = {'S', 'I', 'L', 'V'}; ///< First bytes of every level file
+        const std::uint32_t VERSION = 2;                    ///< Version of the format described here
+
+        /// @brief Position and size of a table inside the file
+        struct Table
+        {
+            std::uint32_t offset; ///< Amount of bytes between the start of the file and the first element
+            std::uint32_t count;  ///< Amount of elements (or bytes for the string table)
+        };
+
+        /// @brief The start of the file
+        struct Header
+        {
+            char          magic[4]; ///< Always equal to MAGIC
+            std::uint32_t version;  ///< Always equal to VERSION
+            std::uint32_t player;   ///< Offset of the Player record
+            Table         strings;  ///< The string table
+            Table         guns;     ///< Gun records
+            Table         levels;   ///< Level records
+            Table         enemies;  ///< Enemy records of all levels
+            Table         walls;    ///< Wall records of all levels
+            Table         bunkers;  ///< Bunker records of all levels
+        };
+
+        /// @brief The type of gun that an entity carries
+        struct Gun
+        {
+            std::uint32_t name;               ///< Name of the gun, used to find the guns of a GunType
+            std::uint32_t bulletImage;        ///< Image of the bullets
+            float         bulletWidth;        ///< Width of the bullets
+            float         bulletHeight;       ///< Height of the bullets
+            float         speed;              ///< Speed of the bullets, negative to fire upwards
+            float         speedPerLevel;      ///< Increase of the bullet speed per level
+            float         coolDown;           ///< Milliseconds between two shots
+            float         coolDownPerLevel;   ///< Increase of the cooldown per level
+            float         fireChance;         ///< How fast the chance of firing increases
+            float         fireChancePerLevel; ///< Increase of the fire chance per level
+        };
+
+        /// @brief The player and its spawn point
+        struct Player
+        {
+            std::uint32_t image;         ///< Image of the player
+            std::uint32_t gun;           ///< Index of the gun in the gun table
+            float         x;             ///< Left side of the spawn point
+            float         y;             ///< Top side of the spawn point
+            float         width;         ///< Width of the player
+            float         height;        ///< Height of the player
+            float         speed;         ///< Speed of the player
+            float         speedPerLevel; ///< Increase of the speed per level
+            std::uint32_t lives;         ///< Lives at the start of a level
+        };
+
+        /// @brief A level, which is a range of enemies, walls and bunkers
+        struct Level
+        {
+            std::uint32_t firstEnemy;  ///< Index of the first enemy in the enemy table
+            std::uint32_t enemyCount;  ///< Amount of enemies in the level
+            std::uint32_t firstWall;   ///< Index of the first wall in the wall table
+            std::uint32_t wallCount;   ///< Amount of walls in the level
+            std::uint32_t firstBunker; ///< Index of the first bunker in the bunker table
+            std::uint32_t bunkerCount; ///< Amount of bunkers in the level
+        };
+
+        /// @brief A single enemy
+        struct Enemy
+        {
+            std::uint32_t image;          ///< Image of the enemy
+            std::uint32_t gun;            ///< Index of the gun in the gun table
+            float         x;              ///< Left side of the enemy
+            float         y;              ///< Top side of the enemy
+            float         width;          ///< Width of the enemy
+            float         height;         ///< Height of the enemy
+            float         speed;          ///< Speed of the enemy
+            float         speedPerLevel;  ///< Increase of the speed per level
+            std::uint32_t points;         ///< Points gained by killing the enemy
+            std::uint32_t pointsPerLevel; ///< Increase of the points per level
+        };
+
+        /// @brief A single block of a defence wall
+        struct Wall
+        {
+            std::uint32_t image;  ///< Image of the wall
+            float         x;      ///< Left side of the wall
+            float         y;      ///< Top side of the wall
+            float         width;  ///< Width of the wall
+            float         height; ///< Height of the wall
+        };
+
+        /// @brief A defence wall made of cells that are shot away one by one
+        struct Bunker
+        {
+            std::uint32_t image;      ///< Image of the cells
+            float         x;          ///< Left side of the bunker
+            float         y;          ///< Top side of the bunker
+            float         width;      ///< Width of the bunker
+            float         height;     ///< Height of the bunker
+            std::uint32_t columns;    ///< Amount of cells in a row, at most 64
+            std::uint32_t rows;       ///< Amount of rows of cells
+            std::uint32_t gapColumns; ///< Width in cells of the opening at the bottom center
+            std::uint32_t gapRows;    ///< Height in cells of the opening at the bottom center
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_LEVEL_FORMAT_HPP
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_STRESS_ENTITY_FACTORY_HPP
+#define SPACE_INVADERS_STRESS_ENTITY_FACTORY_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SpaceInvaders/Factory/AbstractEntityFactory.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Concrete factory in the abstract factory pattern, which fills the screen with a chosen amount
+    ///        of entities to find out how the game behaves when a level grows
+    ///
+    /// The enemies are spread over the top half of the screen and the walls fill a band above the player.
+    /// The bullets are spread over the space above the walls and fly downwards, as if the enemies fired them.
+    /// Bullets of the player would kill the enemies immediately, as they are bigger than crowded enemies.
+    /// The entities get smaller when there are more of them, so that they always fit on the screen.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class StressEntityFactory final : public AbstractEntityFactory
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor
+        ///
+        /// @param enemies  Amount of enemies to create in every level
+        /// @param walls    Amount of wall blocks to create in every level
+        /// @param bullets  Amount of bullets that are flying at the start of every level
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        StressEntityFactory(unsigned int enemies, unsigned int walls, unsigned int bullets);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Look for the stress test option in the command line arguments
+        ///
+        /// @param arguments  The command line arguments, the option and its values are removed from it
+        /// @param option     When not a nullptr, the removed option and its values are stored in it
+        ///
+        /// @return A function that creates a StressEntityFactory when the arguments contained
+        ///         "--stress <enemies> <walls> <bullets>", a nullptr otherwise
+        ///
+        /// @exception std::runtime_error when the values of the option are missing or invalid
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static EntityFactoryCreator parseArguments(std::vector<std::string>& arguments, std::vector<std::string>* option = nullptr);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the enemies
+        ///
+        /// @param difficulty  The difficulty of the level.
+        ///                    This will influence the moving speed, bullet fire rate and bullet speed.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        AttackingEntityList createEnemies(unsigned int difficulty);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the walls
+        ///
+        /// @param difficulty  The difficulty of the level.
+        ///                    In this factory the difficulty has no influence on the walls.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        EntityList createWalls(unsigned int difficulty);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the player
+        ///
+        /// @param difficulty  The difficulty of the level.
+        ///                    This will influence the moving speed, bullet fire rate and bullet speed.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        AttackingEntityPtr createPlayer(unsigned int difficulty);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create a gun which can be attached to an entity
+        ///
+        /// @param difficulty  The difficulty of the level.
+        ///                    This will influence the bullet fire rate and bullet speed.
+        /// @param type        Type of the gun to create
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        Model::Gun createGun(unsigned int difficulty, GunType type);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create the bullets that are already flying when the level starts
+        ///
+        /// @param difficulty  The difficulty of the level.
+        ///                    In this factory the difficulty has no influence on the bullets.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        BulletSpawnList createBullets(unsigned int difficulty);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        unsigned int m_enemies;
+        unsigned int m_walls;
+        unsigned int m_bullets;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_STRESS_ENTITY_FACTORY_HPP
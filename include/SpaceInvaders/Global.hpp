@@ -27,9 +27,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System.hpp>
+#include <stdexcept>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <memory>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -41,6 +43,9 @@ namespace Game
         class Entity;
         class BulletEntity;
         class AttackingEntity;
+        class BunkerEntity;
+        class EntityStore;
+        class Formation;
     }
 
     namespace Controller
@@ -54,6 +59,9 @@ namespace Game
     typedef std::vector<std::shared_ptr<Model::Entity>> EntityList;
     typedef std::shared_ptr<Model::AttackingEntity> AttackingEntityPtr;
     typedef std::vector<std::shared_ptr<Model::AttackingEntity>> AttackingEntityList;
+    typedef std::shared_ptr<Model::BunkerEntity> BunkerPtr;
+    typedef std::vector<std::shared_ptr<Model::BunkerEntity>> BunkerList;
+    typedef unsigned int EntityId;
 
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -106,6 +114,19 @@ namespace Game
     };
 
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief The type of an entity
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    enum class EntityType
+    {
+        Player, ///< The entity controlled by the player
+        Enemy,  ///< One of the enemies
+        Wall,   ///< Part of a defence wall
+        Bullet  ///< A bullet fired by the player or an enemy
+    };
+
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// @brief The type of gun, which will determine the type of the bullets being fired
     ///
@@ -130,6 +151,18 @@ namespace Game
 
     /// @brief The chance to get a powerup after shooting an enemy
     const double POWERUP_CHANCE = 0.035;
+
+    /// @brief How many times per second the game logic is updated (0 means once every frame)
+    const unsigned int TICKS_PER_SECOND = 60;
+
+    /// @brief The maximum amount of updates per frame when the game logic falls behind
+    const unsigned int MAX_TICKS_PER_FRAME = 5;
+
+    /// @brief The amount of bullets that are created up front for every gun at the start of a level
+    const unsigned int BULLET_POOL_SIZE = 32;
+
+    /// @brief The compiled level file from which the clients create the entities
+    const char* const LEVEL_FILENAME = "Resources/Levels.bin";
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
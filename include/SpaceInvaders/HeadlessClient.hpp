@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_HEADLESS_CLIENT_HPP
+#define SPACE_INVADERS_HEADLESS_CLIENT_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SpaceInvaders/Controller/Controller.hpp>
+#include <SpaceInvaders/Factory/LevelEntityFactory.hpp>
+#include <SpaceInvaders/InputRecording.hpp>
+#include <SpaceInvaders/Random.hpp>
+#include <SpaceInvaders/View/NullView.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Result of a single game that was played without a window
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    struct GameResult
+    {
+        std::uint64_t seed;        ///< The seed with which the game was played
+        unsigned int score;        ///< Score at the moment that the game ended
+        unsigned int level;        ///< The level that was being played when the game ended (starting from 1)
+        sf::Time     survivalTime; ///< Game time that passed before the game ended
+        bool         gameOver;     ///< False when the game was stopped before the player lost
+    };
+
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Client that runs the game without a window
+    ///
+    /// The player is controlled by the client itself and levels are loaded one after another, like in
+    /// the normal client. This is meant for measuring the speed of the game logic and for playing a lot
+    /// of games to balance the difficulty.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class HeadlessClient
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief The way in which the player is controlled
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        enum class PlayerType
+        {
+            Scripted, ///< The player stands still and keeps firing
+            AI,       ///< The player moves to the nearest enemy, dodges bullets and keeps firing
+            Replay    ///< The player presses the keys from an input recording
+        };
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor
+        ///
+        /// @param seed        Seed from which the random numbers of every level are derived
+        /// @param playerType  The way in which the player is controlled
+        /// @param createFactory  Creates the factory for every level, the levels are loaded from the level
+        ///                       file when it is a nullptr
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        HeadlessClient(std::uint64_t seed = 0, PlayerType playerType = PlayerType::Scripted, EntityFactoryCreator createFactory = nullptr);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor to replay a recorded session
+        ///
+        /// @param recording  The recording to replay, it has to stay alive as long as the client exists
+        ///
+        /// Calling run with the tick count and tick time of the recording will give the same game as the
+        /// one that was recorded.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        explicit HeadlessClient(const InputRecording& recording);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Update the game a fixed amount of times
+        ///
+        /// @param ticks     Amount of times that the controller will be updated
+        /// @param tickTime  Time that passes in the game during every update
+        ///
+        /// When the game is lost, a new game is started.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void run(unsigned int ticks, const sf::Time& tickTime);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Play until the game is lost
+        ///
+        /// @param maxTicks  The game is stopped after this amount of updates, even when it isn't lost yet
+        /// @param tickTime  Time that passes in the game during every update
+        ///
+        /// @return The result of the game
+        ///
+        /// This function should be called on a newly created client.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        GameResult playGame(unsigned int maxTicks, const sf::Time& tickTime);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the score of the current game
+        ///
+        /// @return Score that was gained since the last game over
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        unsigned int getScore() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return how many levels have been completed
+        ///
+        /// @return Amount of levels that were completed during all calls to run
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        unsigned int getLevelsCompleted() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return how many times the game was lost
+        ///
+        /// @return Amount of game overs during all calls to run
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        unsigned int getGamesLost() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return all points that were gained
+        ///
+        /// @return Sum of the scores of all games, including the current one
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        std::uint64_t getTotalScore() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Update the game once and load another level when needed
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void tick(const sf::Time& tickTime);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Load the next level of the game
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void loadNextLevel();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Decide where the player should move to and queue the key events for it
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void updateAI();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Queue the recorded key events that occurred before the current tick
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void updateReplay();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        std::uint64_t m_seed;
+        PlayerType    m_playerType;
+
+        // Every level gets its own stream that is split off from this one
+        Random m_random;
+
+        // Creates the factory of every level, by default it copies a factory that loaded the level file
+        EntityFactoryCreator m_createFactory;
+
+        unsigned int m_difficulty = 0;
+
+        std::unique_ptr<View::NullView> m_view;
+        std::unique_ptr<Controller::Controller> m_controller;
+
+        unsigned int m_score = 0;
+        unsigned int m_levelsCompleted = 0;
+        unsigned int m_gamesLost = 0;
+        std::uint64_t m_totalScore = 0;
+
+        // The controller can't be replaced while it is sending an event, so it is done after the update
+        bool m_levelComplete = false;
+        bool m_gameOver = false;
+
+        // Direction in which the AI is holding the arrow key (-1 for left, 1 for right, 0 for none)
+        int m_aiDirection = 0;
+
+        // The recording that is being replayed and the next input in it
+        const InputRecording* m_recording = nullptr;
+        std::size_t m_nextInput = 0;
+        std::uint32_t m_tick = 0;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_HEADLESS_CLIENT_HPP
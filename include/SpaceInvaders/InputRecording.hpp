@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_INPUT_RECORDING_HPP
+#define SPACE_INVADERS_INPUT_RECORDING_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <SpaceInvaders/Event.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief The keys that were pressed and released during a session, together with the moment they were pressed
+    ///
+    /// Together with the seed, the duration of a tick and the options that chose the levels, this is everything
+    /// that is needed to play the session again. Because the game logic only depends on those, the replay is
+    /// identical to the original.
+    ///
+    /// In the file, the tick of every input is stored as the difference with the previous input. That
+    /// difference is combined with the key in a single variable length integer, so most inputs only take
+    /// one or two bytes.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class InputRecording
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief A single key that was pressed or released
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct Input
+        {
+            std::uint32_t tick; ///< Amount of ticks that had passed when the key was pressed or released
+            Event::Type   type; ///< One of the key events (e.g. MoveLeftKeyPressed)
+        };
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Default constructor, to create a recording that will be loaded from a file
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        InputRecording() = default;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor to start a new recording
+        ///
+        /// @param seed          Seed of the random numbers in the recorded session
+        /// @param tickTime      Time that passes in the game during every tick, can't be zero
+        /// @param levelOptions  Command line options that replaced the normal levels (e.g. "--stress 10 0 0"),
+        ///                      empty when the levels are loaded from the level file
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        InputRecording(std::uint64_t seed, const sf::Time& tickTime, const std::vector<std::string>& levelOptions = {});
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Add an input to the recording
+        ///
+        /// @param tick  Amount of ticks that have passed, can't be smaller than the tick of the previous input
+        /// @param type  The type of key event, it has to be one for which isInputEvent returns true
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void addInput(std::uint32_t tick, Event::Type type);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Mark the end of the recording
+        ///
+        /// @param tickCount   Amount of ticks that passed during the session
+        /// @param totalScore  All the points that were gained during the session, used to check the replay
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void finish(std::uint32_t tickCount, std::uint64_t totalScore);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Write the recording to a file
+        ///
+        /// @param filename  Path of the file to write
+        ///
+        /// An exception is thrown when the file can't be written.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void saveToFile(const std::string& filename) const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Replace this recording with one that was written to a file
+        ///
+        /// @param filename  Path of the file to read
+        ///
+        /// An exception is thrown when the file can't be read or isn't a valid recording.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void loadFromFile(const std::string& filename);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the seed of the recorded session
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        std::uint64_t getSeed() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the time that passed in the game during every tick
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        sf::Time getTickTime() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the amount of ticks in the recorded session
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        std::uint32_t getTickCount() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return all the points that were gained during the recorded session
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        std::uint64_t getTotalScore() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the command line options that replaced the normal levels in the recorded session
+        ///
+        /// @return The options and their values, empty when the levels were loaded from the level file
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        const std::vector<std::string>& getLevelOptions() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the recorded inputs
+        ///
+        /// @return All inputs, sorted on their tick
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        const std::vector<Input>& getInputs() const;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Check if an event is one of the key events that are recorded
+        ///
+        /// @param type  The type of the event
+        ///
+        /// @return True for the move and fire key events
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static bool isInputEvent(Event::Type type);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        std::uint64_t m_seed = 0;
+        sf::Time      m_tickTime;
+        std::uint32_t m_tickCount = 0;
+        std::uint64_t m_totalScore = 0;
+
+        std::vector<std::string> m_levelOptions;
+        std::vector<Input>       m_inputs;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_INPUT_RECORDING_HPP
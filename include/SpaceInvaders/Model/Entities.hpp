@@ -27,7 +27,9 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstdint>
 #include <SpaceInvaders/Model/Gun.hpp>
+#include <SpaceInvaders/Model/EntityStore.hpp>
 #include <SpaceInvaders/Observable.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -63,7 +65,7 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Changes the position of the entity
             ///
-            /// @param position New position of the entity
+            /// @param position New position of the entity on the screen
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
             void setPosition(const Vector2f& position);
@@ -72,12 +74,22 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Returns the position of the entity
             ///
-            /// @return Current position of the entity
+            /// @return Current position of the entity on the screen
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
             Vector2f getPosition() const;
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the position of the entity relative to its formation
+            ///
+            /// @return Position without the offset of the formation, or the normal position when the
+            ///         entity isn't part of a formation
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            Vector2f getLocalPosition() const;
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Changes the size of the entity
             ///
@@ -96,13 +108,70 @@ namespace Game
             Vector2f getSize() const;
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the area that the entity covers on the screen
+            ///
+            /// @return Rectangle with the position that getPosition returns and the size of the entity
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            FloatRect getBounds() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Sets a moving speed for this entity
+            ///
+            /// @param speed Speed of the entity
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setSpeed(float speed);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the moving speed of the entity
+            ///
+            /// @return Speed of the entity
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            float getSpeed() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the type of the entity
+            ///
+            /// @return Type of the entity
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            virtual EntityType getType() const = 0;
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Returns the filename of the image used to display the entity
             ///
             /// @return Filename which was passed to this model through the constructor
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            std::string getImageFilename() const;
+            const std::string& getImageFilename() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Shows or hides the entity
+            ///
+            /// @param visible True to show the entity, false to hide it
+            ///
+            /// A hidden entity is not drawn and is skipped in the loops over the entity store.
+            /// Unlike destroying it, the entity can be shown again later so that it can be reused.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setVisible(bool visible);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns whether the entity is visible
+            ///
+            /// @return False when the entity was hidden with setVisible, true otherwise
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            bool isVisible() const;
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -112,10 +181,108 @@ namespace Game
             virtual void destroy();
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Keep the position, size and speed of the entity up to date in a store
+            ///
+            /// @param store  The store in which the data of the entity will be kept
+            ///
+            /// When the entity was already attached to another store then it is first detached from it.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void attachToStore(EntityStore& store);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Stop keeping the data of the entity in the store
+            ///
+            /// This happens automatically when the entity or the store is destroyed.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void detachFromStore();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the store to which the entity is attached
+            ///
+            /// @return The store, or a nullptr when the entity isn't attached to a store
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            EntityStore* getStore() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the id of the entity inside the store
+            ///
+            /// @return Index of the entity in the arrays of the store (only valid when attached to a store)
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            EntityId getStoreId() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Let the entity move together with a formation
+            ///
+            /// @param formation  The formation to join
+            ///
+            /// The entity keeps its current position on the screen. From now on only its position relative
+            /// to the formation is stored. When the entity was already part of
+            /// another formation then it first leaves that formation.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void joinFormation(Formation& formation);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Stop moving together with the formation
+            ///
+            /// The entity keeps its current position on the screen.
+            /// This happens automatically when the entity or the formation is destroyed.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void leaveFormation();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the formation to which the entity belongs
+            ///
+            /// @return The formation, or a nullptr when the entity isn't part of a formation
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            Formation* getFormation() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Change the place of the entity in the member list of its formation
+            ///
+            /// @param index  Index of the entity in the list of members
+            ///
+            /// This function is called by the formation, it should not be called directly.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setFormationIndex(std::size_t index);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the place of the entity in the member list of its formation
+            ///
+            /// @return Index that was last passed to setFormationIndex
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            std::size_t getFormationIndex() const;
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
         protected:
             FloatRect m_area = FloatRect{0, 0, 0, 0};
+            float m_speed = 0;
+            bool m_visible = true;
             std::string m_imageFilename;
+
+            EntityStore* m_store = nullptr;
+            EntityId m_storeId = 0;
+
+            Formation* m_formation = nullptr;
+            std::size_t m_formationIndex = 0;
         };
 
 
@@ -154,45 +321,148 @@ namespace Game
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// @brief Sets a moving speed for this entity
-            ///
-            /// @param speed Speed of the entity
-            ///
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-            void setSpeed(float speed);
+        private:
+            Gun m_gun;
+        };
 
 
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief The defense wall entity
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class WallEntity final : public Entity
+        {
+        public:
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// @brief Returns the moving speed of the entity
+            /// @brief Constructor to initialize the wall
             ///
-            /// @return Speed of the entity
+            /// @param filename Filename of the image needed to display the wall
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            float getSpeed() const;
+            WallEntity(const std::string& filename);
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
-        private:
-            Gun   m_gun;
-            float m_speed = 0;
+            /// @brief Returns the type of the entity
+            ///
+            /// @return EntityType::Wall
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            EntityType getType() const;
         };
 
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        /// @brief The defense wall entity
+        /// @brief A defense wall that is shot away piece by piece
+        ///
+        /// The bunker is a grid of small cells, every row of which is stored as the bits of a single integer.
+        /// A bullet only has to be compared with the few rows that it overlaps, and it removes the cells
+        /// around the place where it hit.
         ///
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        class WallEntity final : public Entity
+        class BunkerEntity final : public Entity
         {
         public:
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// @brief Constructor to initialize the wall
+            /// @brief The maximum amount of columns, one per bit in a row
             ///
-            /// @param filename Filename of the image needed to display the wall
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            static const unsigned int MAX_COLUMNS = 64;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Constructor to initialize the bunker with all cells present
+            ///
+            /// @param filename Filename of the image needed to display the cells
+            /// @param columns  Amount of cells in a row, at most MAX_COLUMNS
+            /// @param rows     Amount of rows
+            /// @param cellSize Size of a single cell, the size of the bunker follows from it
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            WallEntity(const std::string& filename);
+            BunkerEntity(const std::string& filename, unsigned int columns, unsigned int rows, const Vector2f& cellSize);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the type of the entity
+            ///
+            /// @return EntityType::Wall
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            EntityType getType() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove a rectangle of cells, e.g. to give the bunker its shape
+            ///
+            /// @param column   First column to remove
+            /// @param row      First row to remove
+            /// @param columns  Amount of columns to remove
+            /// @param rows     Amount of rows to remove
+            ///
+            /// The part of the rectangle that lies outside the bunker is ignored.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void removeCells(unsigned int column, unsigned int row, unsigned int columns, unsigned int rows);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Check whether an area hits one of the cells and shoot away the cells around it
+            ///
+            /// @param bounds  The area of the bullet
+            ///
+            /// @return True when a cell was hit, the observers then receive a BunkerDamaged event
+            ///
+            /// The cells are removed in an area three times as wide and high as the bullet, centered around it.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            bool erode(const FloatRect& bounds);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the amount of cells in a row
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            unsigned int getColumns() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the size of a single cell
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            Vector2f getCellSize() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the cells, bit i of a row is set when the cell in column i is still there
+            ///
+            /// @return One integer per row, from top to bottom
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const std::vector<std::uint64_t>& getCells() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Find the columns and rows of the cells that overlap with an area, returns false when there are none.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            bool getCellRange(const FloatRect& area, unsigned int& left, unsigned int& top, unsigned int& right, unsigned int& bottom) const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Returns a row in which the bits from the first until the last column are set.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            static std::uint64_t getColumnMask(unsigned int firstColumn, unsigned int lastColumn);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            unsigned int m_columns;
+            Vector2f     m_cellSize;
+            std::vector<std::uint64_t> m_cells;
         };
 
 
@@ -215,6 +485,15 @@ namespace Game
             EnemyEntity(const std::string& filename, const Gun& gun, unsigned int killPoints);
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the type of the entity
+            ///
+            /// @return EntityType::Enemy
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            EntityType getType() const;
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Returns the points that you will receive when killing this enemy
             ///
@@ -255,6 +534,15 @@ namespace Game
             PlayerEntity(const std::string& filename, const Gun& gun);
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the type of the entity
+            ///
+            /// @return EntityType::Player
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            EntityType getType() const;
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Sets the remaining lives of the player
             ///
@@ -298,17 +586,12 @@ namespace Game
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// @brief Returns how fast the bullet moves
+            /// @brief Returns the type of the entity
             ///
-            /// @return The speed of the bullet
+            /// @return EntityType::Bullet
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            float getSpeed() const;
-
-
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-        protected:
-            float m_speed;
+            EntityType getType() const;
         };
     }
 }
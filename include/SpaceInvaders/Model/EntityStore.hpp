@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_ENTITY_STORE_HPP
+#define SPACE_INVADERS_ENTITY_STORE_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SpaceInvaders/Global.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace Model
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Storage for the data of entities, with every property kept in its own contiguous array
+        ///
+        /// Entities that are attached to the store write their position, size, speed and whether they are
+        /// alive into it whenever these change. Code that has to go over many entities can read these arrays
+        /// without touching the entities themselves. The positions are always on the screen, for the members
+        /// of a formation they are updated whenever the formation moves.
+        ///
+        /// Every entity gets an id, which is the index in the arrays. The id of a removed entity is reused.
+        /// Ids that are not in use are marked as not alive, just like entities that were destroyed.
+        /// The arrays can only be read, changes have to be made through the entities so that their
+        /// observers are still notified.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class EntityStore
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Default constructor
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            EntityStore() = default;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Destructor
+            ///
+            /// The entities that are still attached will be detached, they keep working on their own.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            ~EntityStore();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief The store can't be copied because the entities point to it
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            EntityStore(const EntityStore&) = delete;
+            EntityStore& operator=(const EntityStore&) = delete;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add an entity to the store
+            ///
+            /// @param entity  The entity to add
+            ///
+            /// @return The id of the entity in the store
+            ///
+            /// This function is called by Entity::attachToStore, you should not call it yourself.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            EntityId add(Entity* entity);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove an entity from the store
+            ///
+            /// @param id  The id of the entity to remove
+            ///
+            /// This function is called by Entity::detachFromStore, you should not call it yourself.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void remove(EntityId id);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Change the position of an entity in the store
+            ///
+            /// @param id        The id of the entity
+            /// @param position  New position of the entity on the screen
+            ///
+            /// This function is called by Entity::setPosition and when the formation of the entity moves,
+            /// you should not call it yourself.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setPosition(EntityId id, const Vector2f& position);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Change the size of an entity in the store
+            ///
+            /// @param id    The id of the entity
+            /// @param size  New size of the entity
+            ///
+            /// This function is called by Entity::setSize, you should not call it yourself.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setSize(EntityId id, const Vector2f& size);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Change the speed of an entity in the store
+            ///
+            /// @param id     The id of the entity
+            /// @param speed  New speed of the entity
+            ///
+            /// This function is called by Entity::setSpeed, you should not call it yourself.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setSpeed(EntityId id, float speed);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Mark an entity as alive or dead, dead entities are skipped by the loops over the store
+            ///
+            /// @param id     The id of the entity
+            /// @param alive  False when the entity was destroyed or hidden, true when it is shown again
+            ///
+            /// This function is called by Entity::destroy and Entity::setVisible, you should not call it yourself.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setAlive(EntityId id, bool alive);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the amount of ids, including the ones that are not alive
+            ///
+            /// @return The size of all the arrays
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            std::size_t getIdCount() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the positions of the entities
+            ///
+            /// @return Position of every entity on the screen, indexed by id
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const std::vector<Vector2f>& getPositions() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the sizes of the entities
+            ///
+            /// @return Size of every entity, indexed by id
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const std::vector<Vector2f>& getSizes() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the bounds of an entity
+            ///
+            /// @param id  The id of the entity
+            ///
+            /// @return The position and size of the entity combined in a rectangle
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            FloatRect getBounds(EntityId id) const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the speeds of the entities
+            ///
+            /// @return Speed of every entity, indexed by id
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const std::vector<float>& getSpeeds() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the types of the entities
+            ///
+            /// @return Type of every entity, indexed by id
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const std::vector<EntityType>& getTypes() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the alive flags of the entities
+            ///
+            /// @return Whether the id belongs to an entity that hasn't been destroyed, indexed by id
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const std::vector<unsigned char>& getAlive() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the entities in the store
+            ///
+            /// @return Pointer to every entity, or a nullptr when the id isn't in use, indexed by id
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const std::vector<Entity*>& getEntities() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            std::vector<Vector2f>      m_positions;
+            std::vector<Vector2f>      m_sizes;
+            std::vector<float>         m_speeds;
+            std::vector<EntityType>    m_types;
+            std::vector<unsigned char> m_alive;
+            std::vector<Entity*>       m_entities;
+
+            std::vector<EntityId> m_freeIds;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        inline void EntityStore::setPosition(EntityId id, const Vector2f& position)
+        {
+            m_positions[id] = position;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        inline FloatRect EntityStore::getBounds(EntityId id) const
+        {
+            return FloatRect{m_positions[id].x, m_positions[id].y, m_sizes[id].x, m_sizes[id].y};
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_ENTITY_STORE_HPP
@@ -0,0 +1,200 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_FORMATION_HPP
+#define SPACE_INVADERS_FORMATION_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SpaceInvaders/Observable.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace Model
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Group of entities that move together
+        ///
+        /// The members only store their position relative to the formation. Moving the whole group is done
+        /// by changing the offset of the formation, the members themselves are not touched. The formation
+        /// does write the new positions on the screen into the entity store of the members.
+        ///
+        /// A PositionChanged event (without entity) is send when the offset changes and a Destroyed event
+        /// is send when the formation is destroyed.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class Formation : public Observable
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Default constructor
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            Formation() = default;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief The formation can't be copied, the members point to it
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            Formation(const Formation&) = delete;
+            Formation& operator=(const Formation&) = delete;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Destructor, the members that are left will keep their current position
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            ~Formation();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add an entity to the formation
+            ///
+            /// @param entity  The entity that will move together with the formation
+            ///
+            /// This function is called by Entity::joinFormation, it should not be called directly.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void addMember(Entity* entity);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove an entity from the formation
+            ///
+            /// @param entity  The entity that should no longer move together with the formation
+            ///
+            /// This function is called by Entity::leaveFormation, it should not be called directly.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void removeMember(Entity* entity);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Move the whole formation
+            ///
+            /// @param offset  New position of the formation, which is added to the positions of the members
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setOffset(const Vector2f& offset);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the position of the formation
+            ///
+            /// @return Offset that is added to the positions of the members
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const Vector2f& getOffset() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Changes the horizontal direction in which the formation is marching
+            ///
+            /// @param direction  1 to move to the right, -1 to move to the left
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setDirection(float direction);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the horizontal direction in which the formation is marching
+            ///
+            /// @return 1 when moving to the right, -1 when moving to the left
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            float getDirection() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns the area covered by the members
+            ///
+            /// @return Smallest rectangle on the screen that contains all members
+            ///
+            /// Only valid when the formation has members. The area is only calculated again when members
+            /// were added, removed or changed since the last call.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            FloatRect getBounds() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Returns whether there are entities in the formation
+            ///
+            /// @return True when the formation has no members
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            bool isEmpty() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Called by a member when its position, size or store has changed
+            ///
+            /// @param entity  The member that changed
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void memberChanged(Entity* entity);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Recalculate the area covered by the members, relative to the formation
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void updateBounds() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            // Copy of what setOffset needs, so that moving the formation doesn't have to visit the entities
+            struct Member
+            {
+                Entity*      entity;
+                EntityStore* store; // nullptr when the entity isn't attached to a store
+                EntityId     storeId;
+                Vector2f     localPosition;
+            };
+
+            std::vector<Member> m_members;
+
+            Vector2f  m_offset = Vector2f{0, 0};
+            float     m_direction = 1;
+
+            // The bounds are calculated when they are needed, so that adding or removing many members at once
+            // doesn't calculate them again for every member
+            mutable FloatRect m_localBounds = FloatRect{0, 0, 0, 0};
+            mutable bool      m_boundsOutdated = false;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_FORMATION_HPP
@@ -62,7 +62,7 @@ namespace Game
             /// @return Filename of the bullet which this gun fires
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            std::string getBulletFilename() const;
+            const std::string& getBulletFilename() const;
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,10 +113,17 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Make an attempt to fire a bullet
             ///
+            /// @param currentTime     Time that has passed in the game since the start of the level
+            /// @param fireRateFactor  Factor with which the fire rate is multiplied, the cooldown time is
+            ///                        divided by it
+            ///
             /// @return True when a bullet is fired, false when the cooldown time hasn't expired yet
             ///
+            /// The cooldown time is measured in game time, so that the gun behaves the same when the game
+            /// runs faster or slower than real time. The gun counts as being fired at the start of the level.
+            ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            bool tryToFire();
+            bool tryToFire(const sf::Time& currentTime, float fireRateFactor = 1);
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -127,7 +134,7 @@ namespace Game
             float       m_bulletSpeed;
 
             sf::Time    m_coolDownTime;
-            sf::Clock   m_cooldownTimer;
+            sf::Time    m_lastFireTime;
 
             float       m_chanceIncrease;
         };
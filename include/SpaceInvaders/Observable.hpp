@@ -22,13 +22,16 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+
 #ifndef SPACE_INVADERS_OBSERVABLE_HPP
 #define SPACE_INVADERS_OBSERVABLE_HPP
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#include <map>
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <vector>
 #include <SpaceInvaders/Event.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +46,17 @@ namespace Game
     {
     public:
 
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Handle that is returned when adding an observer, it is needed to remove the observer again
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct ObserverHandle
+        {
+            Event::Type  eventType; ///< The type of event that the observer is listening to
+            unsigned int id;        ///< Unique number of the observer within the observable object
+        };
+
+
         ////////////////////////////////////////////////////////////////////////////////////////////////////
         /// @brief Destructor
         ///
@@ -56,8 +70,22 @@ namespace Game
         /// @param function  The function to call when the event occurs
         /// @param eventType The type of event for which the function will be signaled
         ///
+        /// @return Handle that can be passed to removeObserver when the function may no longer be called
+        ///
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        void addObserver(std::function<void(const Event&)> function, Event::Type eventType);
+        ObserverHandle addObserver(std::function<void(const Event&)> function, Event::Type eventType);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Remove an observer that was added earlier
+        ///
+        /// @param handle  The handle that was returned by addObserver
+        ///
+        /// It is safe to call this function while the observers are being notified,
+        /// the removed observer will not be called anymore.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void removeObserver(const ObserverHandle& handle);
 
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -67,6 +95,30 @@ namespace Game
         void clearObservers();
 
 
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Choose between calling the observers immediately or queueing the events
+        ///
+        /// @param enabled  When true, notifying the observers only adds the event to a queue
+        ///
+        /// Queued events are only passed to the observers when dispatchQueuedEvents is called. This lets the
+        /// owner decide at which point the observers run, so that they never run while it is in the middle
+        /// of looping over its entities. Disabling the queueing doesn't dispatch the events that are queued.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void setEventQueueing(bool enabled);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Pass the queued events to the observers
+        ///
+        /// The events are grouped by type, so all events of one type are handled after each other by the
+        /// same observers. Events of the same type keep the order in which they were queued.
+        /// Events that are queued by the observers themselves are dispatched before this function returns.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void dispatchQueuedEvents();
+
+
         ////////////////////////////////////////////////////////////////////////////////////////////////////
     protected:
 
@@ -78,8 +130,57 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
     private:
-        std::map<Event::Type, std::vector<std::function<void(const Event&)>>> m_observers;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Call the observers of the event, this is only called when there are observers
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void dispatch(const Event& event);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Erase the observers that were removed while the observers were being notified
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void eraseRemovedObservers();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+
+        // An observer is only marked as removed during dispatching, it is erased afterwards
+        struct Observer
+        {
+            std::function<void(const Event&)> function;
+            unsigned int id;
+            bool removed;
+        };
+
+        std::array<std::vector<Observer>, static_cast<std::size_t>(Event::Type::Count)> m_observers;
+
+        unsigned int m_nextObserverId = 0;
+        unsigned int m_dispatchDepth = 0;
+        bool         m_observersRemoved = false;
+
+        // The queue is kept between ticks so that it stops allocating, one bit per event type in the queue
+        std::vector<Event> m_queuedEvents;
+        std::uint32_t      m_queuedTypes = 0;
+        bool               m_queueEvents = false;
     };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    inline void Observable::notifyObservers(const Event& event)
+    {
+        if (m_observers[static_cast<std::size_t>(event.type)].empty())
+            return;
+
+        if (m_queueEvents)
+        {
+            m_queuedEvents.push_back(event);
+            m_queuedTypes |= std::uint32_t{1} << static_cast<unsigned int>(event.type);
+        }
+        else
+            dispatch(event);
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_PROFILER_HPP
+#define SPACE_INVADERS_PROFILER_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Process-wide profiler that measures how long the different phases of a frame take
+    ///
+    /// Every phase keeps its most recent samples in a ring buffer. Adding a sample never takes a lock,
+    /// so the timers can be used from multiple threads at once. The statistics are calculated from the
+    /// samples that are in the ring buffer at the moment they are requested.
+    ///
+    /// Profiling is disabled by default, a disabled timer only costs a single atomic load.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class Profiler
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief The parts of a frame that are measured
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        enum class Phase
+        {
+            PlayerUpdate,  ///< PlayerController::update
+            EnemyUpdate,   ///< EnemyController::update
+            PowerupUpdate, ///< PowerupController::update
+            BulletUpdate,  ///< Controller::updateBullets
+            HandleEvents,  ///< Polling and handling the events of the window
+            Draw,          ///< Drawing the window
+            Count          ///< Keep last -- the amount of phases
+        };
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Statistics of the samples of a phase, all times are in microseconds
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct Statistics
+        {
+            std::size_t samples = 0; ///< Amount of samples on which the statistics are based
+            double      min = 0;     ///< Shortest duration
+            double      average = 0; ///< Average duration
+            double      p99 = 0;     ///< 99% of the samples took at most this long
+            double      max = 0;     ///< Longest duration
+        };
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Measures the time between its construction and destruction and adds it as a sample
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class ScopedTimer
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Start measuring
+            ///
+            /// @param phase  The phase to which the sample will be added
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            explicit ScopedTimer(Phase phase);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Stop measuring and add the sample
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            ~ScopedTimer();
+
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            Phase m_phase;
+            bool  m_enabled;
+            std::chrono::steady_clock::time_point m_start;
+        };
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Start or stop profiling
+        ///
+        /// @param enabled  True to let the timers add samples
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static void setEnabled(bool enabled);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Check whether the timers are adding samples
+        ///
+        /// @return True when profiling is enabled
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static bool isEnabled();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Add a sample to a phase
+        ///
+        /// @param phase        The phase that was measured
+        /// @param nanoseconds  How long the phase took
+        ///
+        /// The oldest sample of the phase is overwritten when its ring buffer is full.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static void addSample(Phase phase, std::uint32_t nanoseconds);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Calculate the statistics of a phase
+        ///
+        /// @param phase  The phase of which the statistics are requested
+        ///
+        /// @return Statistics of the most recent samples of the phase
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static Statistics getStatistics(Phase phase);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the name of a phase
+        ///
+        /// @param phase  The phase of which the name is requested
+        ///
+        /// @return Name of the phase as shown in the overlay and the CSV file
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static const char* getPhaseName(Phase phase);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Write the statistics of all phases to a CSV file
+        ///
+        /// @param filename  Path of the file to write
+        ///
+        /// @exception std::runtime_error when the file could not be written
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static void writeCsv(const std::string& filename);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Throw away all samples
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static void clear();
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_PROFILER_HPP
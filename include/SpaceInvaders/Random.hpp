@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_RANDOM_HPP
+#define SPACE_INVADERS_RANDOM_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstdint>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Fast random number generator that gives the same numbers on every platform
+    ///
+    /// The generator is a xoshiro256** generator. Its state is filled from a 64-bit seed with splitmix64,
+    /// so seeds that only differ in a few bits still give completely different numbers.
+    ///
+    /// Every subsystem should get its own stream by calling split, so that the numbers drawn by one
+    /// subsystem don't change when another subsystem starts drawing more or less numbers. The streams
+    /// don't overlap until 2^128 numbers have been drawn from one of them.
+    ///
+    /// The class satisfies the UniformRandomBitGenerator requirements, but the member functions should be
+    /// preferred over the distributions from the standard library, because the results of those differ
+    /// between implementations.
+    ///
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class Random
+    {
+    public:
+
+        using result_type = std::uint64_t;
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor
+        ///
+        /// @param seed  Seed from which the whole stream is derived
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        explicit Random(std::uint64_t seed = 0);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create an independent stream for another subsystem
+        ///
+        /// @return Generator that starts where this one was, while this one jumps 2^128 numbers ahead
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        Random split();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the next random number
+        ///
+        /// @return Number between 0 and 2^64-1
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        std::uint64_t next();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return a random integer below a given bound
+        ///
+        /// @param bound  Upper bound, which is never returned itself
+        ///
+        /// @return Number in the range [0, bound), or 0 when the bound is 0
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        std::uint32_t nextInt(std::uint32_t bound);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return a random floating point number between 0 and 1
+        ///
+        /// @return Number in the range [0, 1)
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        double nextDouble();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return a random floating point number in a given range
+        ///
+        /// @param min  Lowest value that can be returned
+        /// @param max  Upper bound, which is never returned itself
+        ///
+        /// @return Number in the range [min, max)
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        float nextFloat(float min, float max);
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the next random number, needed to use the class with the standard library
+        ///
+        /// @return Number between 0 and 2^64-1
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        result_type operator()();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the smallest number that can be generated
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static constexpr result_type min()
+        {
+            return 0;
+        }
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Return the largest number that can be generated
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static constexpr result_type max()
+        {
+            return UINT64_MAX;
+        }
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Create a seed that is different every time the game is started
+        ///
+        /// @return Seed based on the current time and the random device of the system
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        static std::uint64_t createSeed();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        // Move 2^128 numbers ahead in the stream
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        void jump();
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    private:
+        std::array<std::uint64_t, 4> m_state;
+    };
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_RANDOM_HPP
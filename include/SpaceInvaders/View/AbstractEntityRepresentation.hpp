@@ -49,8 +49,21 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Display the entity in some way
             ///
+            /// @param interpolation  Value between 0 and 1 that tells how far we are between the previous
+            ///                       and the current update of the game logic
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            virtual void draw(float interpolation) = 0;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Called right before the game logic is updated
+            ///
+            /// The representation can remember the current state of the entity here, so that it can
+            /// interpolate between the previous and the current state while drawing.
+            ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            virtual void draw() = 0;
+            virtual void tickStarted() {}
         };
     }
 }
@@ -92,6 +92,19 @@ namespace Game
             virtual void removeMessage() = 0;
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove everything that belongs to the current level, so that the view can be reused
+            ///
+            /// @param gameState  State of the game
+            /// @param score      Current score to be displayed
+            ///
+            /// All entity representations are removed, but the resources that are shared between the levels
+            /// (e.g. the window) are kept. The entities of the level should be destroyed before calling this.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            virtual void resetScene(GameState gameState, unsigned int score);
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Called when an entity gets destroyed
             ///
@@ -111,6 +124,26 @@ namespace Game
             void livesChanged(const Event& event);
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Called right before the game logic is updated
+            ///
+            /// All entity representations will be given a chance to remember the current state of their entity.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void tickStarted();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Tell the view how far it is between the previous and the current update of the game logic
+            ///
+            /// @param interpolation  Value between 0 (previous update) and 1 (current update)
+            ///
+            /// The value will be used by the following calls to draw.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setInterpolation(float interpolation);
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
         protected:
 
@@ -128,6 +161,11 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
         protected:
             std::vector<std::unique_ptr<AbstractEntityRepresentation>> m_entities;
+
+            float m_interpolation = 1;
+
+            // Set when the entities may have moved or were added or removed since the view last cleared it
+            bool m_sceneChanged = true;
         };
     }
 }
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_HUD_HPP
+#define SPACE_INVADERS_HUD_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <SpaceInvaders/Global.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief The text that is drawn on top of the game: the score, the lives, messages and the menus
+        ///
+        /// The score and lives are kept as numbers. The texts are only rebuilt and positioned again when
+        /// the value that they show has changed, so drawing an unchanged screen only costs the draw calls.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class Hud
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Constructor to initialize the hud
+            ///
+            /// @param font   Font of all texts, it has to stay alive as long as the hud exists
+            /// @param score  Score to display
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            Hud(const sf::Font& font, unsigned int score);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Change the displayed score
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setScore(unsigned int score);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add points to the displayed score
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void addScore(unsigned int points);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Change the displayed amount of lives
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setLives(unsigned int lives);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Stop showing the lives until setLives is called again
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void hideLives();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Display a message at the top of the screen while playing
+            ///
+            /// @param message  Message to show, an empty string removes the message
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setMessage(const std::string& message);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Draw the texts that belong to a game state
+            ///
+            /// @param target     Where to draw the texts
+            /// @param gameState  The state that decides which texts are shown
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void draw(sf::RenderTarget& target, GameState gameState);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Rebuild the texts of which the value has changed since they were last drawn.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void update();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Create a text that is centered horizontally and vertically around the given height.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            sf::Text createCenteredText(const std::string& string, unsigned int characterSize, float centerY) const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            const sf::Font& m_font;
+
+            unsigned int m_score;
+            unsigned int m_lives = 0;
+            bool         m_livesVisible = false;
+            std::string  m_message;
+
+            // Set when the value changed but the text wasn't rebuilt yet
+            bool m_scoreDirty = true;
+            bool m_livesDirty = true;
+
+            sf::Text m_scoreText;
+            sf::Text m_livesText;
+            sf::Text m_messageText;
+
+            // Texts of the menus, these never change
+            sf::Text m_mainMenuHeader;
+            sf::Text m_mainMenuInstruction;
+            sf::Text m_pausedHeader;
+            sf::Text m_gameOverHeader;
+            sf::Text m_gameOverScore;
+            sf::Text m_continueInstruction;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_HUD_HPP
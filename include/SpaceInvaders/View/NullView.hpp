@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_NULL_VIEW_HPP
+#define SPACE_INVADERS_NULL_VIEW_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <deque>
+#include <SpaceInvaders/View/AbstractView.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief View that does not display anything
+        ///
+        /// It does not open a window, so it can be used to run the game logic on machines without a screen.
+        /// Input can be simulated by queueing events, they will be send when handleEvents is called.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class NullView : public AbstractView
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add an entity to the view
+            ///
+            /// @param entity  The entity to be added to the view
+            ///
+            /// The entity will not be displayed, so this function does nothing.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void addEntity(const EntityPtr entity);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Send the queued events to anyone interested
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void handleEvents();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Does nothing, there is nothing to draw on
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void draw();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remember the message without displaying it
+            ///
+            /// @param message  Message to show
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void setMessage(const std::string& message);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Forget the message
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void removeMessage();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Forget the message and the events that weren't send yet
+            ///
+            /// @param gameState  State of the game
+            /// @param score      Current score
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void resetScene(GameState gameState, unsigned int score);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Queue an event which will be send during the next call to handleEvents
+            ///
+            /// @param event  The event to send (e.g. MoveLeftKeyPressed)
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void queueEvent(const Event& event);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the message that would be displayed
+            ///
+            /// @return The last message passed to setMessage, or an empty string when it was removed
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const std::string& getMessage() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the lives that would be displayed
+            ///
+            /// @return The lives that the player has left
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            unsigned int getLives() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Called when the lives have changed.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void updateLives(unsigned int lives);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            std::deque<Event> m_queuedEvents;
+
+            std::string  m_message;
+            unsigned int m_lives = 0;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_NULL_VIEW_HPP
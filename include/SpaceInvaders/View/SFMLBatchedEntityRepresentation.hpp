@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_SFML_BATCHED_ENTITY_REPRESENTATION_HPP
+#define SPACE_INVADERS_SFML_BATCHED_ENTITY_REPRESENTATION_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <SpaceInvaders/View/SFMLInterpolatedEntityRepresentation.hpp>
+#include <SpaceInvaders/View/TextureAtlas.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Class for displaying an entity as part of a batch of entities that share a texture atlas
+        ///
+        /// Instead of drawing the entity directly, its quad is added to a vertex array.
+        /// The view draws the whole vertex array at once with the texture of the atlas.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class SFMLBatchedEntityRepresentation : public SFMLInterpolatedEntityRepresentation
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Constructor to initialize the entity representation
+            ///
+            /// @param vertices  Vertex array to which the quad of the entity will be added when drawing
+            /// @param atlas     Texture atlas to which the image of the entity will be added
+            /// @param entity    The entity to display
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            SFMLBatchedEntityRepresentation(sf::VertexArray& vertices, TextureAtlas& atlas, EntityPtr entity);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add the quad of the entity to the vertex array
+            ///
+            /// @param interpolation  Value between 0 and 1 that tells how far we are between the previous
+            ///                       and the current update of the game logic
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void draw(float interpolation);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            sf::VertexArray& m_vertices;
+
+            sf::FloatRect m_textureRect;
+            sf::Vector2f  m_size;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_SFML_BATCHED_ENTITY_REPRESENTATION_HPP
@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SPACE_INVADERS_SFML_BUNKER_REPRESENTATION_HPP
+#define SPACE_INVADERS_SFML_BUNKER_REPRESENTATION_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <functional>
+#include <SFML/Graphics.hpp>
+#include <SpaceInvaders/Observable.hpp>
+#include <SpaceInvaders/View/AbstractEntityRepresentation.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Class for displaying the cells of a bunker
+        ///
+        /// The cells are not drawn one by one. Every horizontal run of cells becomes a single rectangle and
+        /// rows that are equal to the row above them are merged with it, so an undamaged bunker only needs
+        /// a few rectangles. How a rectangle is drawn is left to the view.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class SFMLBunkerRepresentation : public AbstractEntityRepresentation
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Function that draws the image of the bunker stretched over a rectangle
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            typedef std::function<void(const sf::Vector2f& position, const sf::Vector2f& size)> DrawRectFunction;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Constructor to initialize the bunker representation
+            ///
+            /// @param drawRect  Function that is called for every rectangle of cells when drawing
+            /// @param bunker    The bunker to display
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            SFMLBunkerRepresentation(DrawRectFunction drawRect, BunkerPtr bunker);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Draw the remaining cells of the bunker
+            ///
+            /// @param interpolation  Not used, bunkers don't move
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void draw(float interpolation);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Callback function for when cells of the bunker were shot away
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void bunkerDamaged(const Event& event);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            DrawRectFunction m_drawRect;
+
+            sf::Vector2f m_position;
+            sf::Vector2f m_cellSize;
+
+            // Copy of the cells of the bunker, bit i of a row is set when the cell in column i is there
+            std::vector<std::uint64_t> m_cells;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_SFML_BUNKER_REPRESENTATION_HPP
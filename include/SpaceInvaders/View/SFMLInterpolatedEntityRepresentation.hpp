@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_SFML_INTERPOLATED_ENTITY_REPRESENTATION_HPP
+#define SPACE_INVADERS_SFML_INTERPOLATED_ENTITY_REPRESENTATION_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <SpaceInvaders/Observable.hpp>
+#include <SpaceInvaders/View/AbstractEntityRepresentation.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Base class for displaying an entity between its previous and current position
+        ///
+        /// Keeps track of the position and visibility of the entity, also when it moves together with a
+        /// formation. The derived classes only decide how the entity is drawn.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class SFMLInterpolatedEntityRepresentation : public AbstractEntityRepresentation
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Constructor to initialize the entity representation
+            ///
+            /// @param entity  The entity to display
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            SFMLInterpolatedEntityRepresentation(const EntityPtr& entity);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Destructor
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            ~SFMLInterpolatedEntityRepresentation();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remember the current position, the entity will be drawn between this and the next position
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void tickStarted();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        protected:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Returns the position between the previous and the current position
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            sf::Vector2f getInterpolatedPosition(float interpolation) const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Callback function for when the position of the entity is changed
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void positionChanged(const Event& event);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Callback function for when the entity is hidden or shown
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void visibilityChanged(const Event& event);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Callback functions for when the formation of the entity has moved or is destroyed
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void formationMoved(const Event& event);
+            void formationDestroyed(const Event& event);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        protected:
+            sf::Vector2f m_previousPosition;
+            sf::Vector2f m_currentPosition;
+
+            bool m_visible = true;
+
+        private:
+            // Entities in a formation only report their position relative to the formation
+            Model::Formation* m_formation = nullptr;
+            std::vector<Observable::ObserverHandle> m_formationObservers;
+            sf::Vector2f m_localPosition;
+            sf::Vector2f m_formationOffset;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_SFML_INTERPOLATED_ENTITY_REPRESENTATION_HPP
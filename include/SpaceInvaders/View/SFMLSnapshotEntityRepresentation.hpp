@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SPACE_INVADERS_SFML_SNAPSHOT_ENTITY_REPRESENTATION_HPP
+#define SPACE_INVADERS_SFML_SNAPSHOT_ENTITY_REPRESENTATION_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <SFML/Graphics.hpp>
+#include <SpaceInvaders/View/SFMLInterpolatedEntityRepresentation.hpp>
+#include <SpaceInvaders/View/SceneSnapshot.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Class for displaying an entity that is drawn by another thread
+        ///
+        /// Instead of drawing the entity, its image and positions are added to the sprites of a scene snapshot.
+        /// The render thread turns the sprites into quads, so nothing here touches the graphics card.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class SFMLSnapshotEntityRepresentation : public SFMLInterpolatedEntityRepresentation
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Constructor to initialize the entity representation
+            ///
+            /// @param sprites  List to which the sprite of the entity will be added when drawing
+            /// @param image    Index of the image of the entity in the images of the snapshot
+            /// @param entity   The entity to display
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            SFMLSnapshotEntityRepresentation(std::vector<SceneSnapshot::Sprite>& sprites, unsigned int image, EntityPtr entity);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add the sprite of the entity to the list of sprites
+            ///
+            /// @param interpolation  Not used, the render thread interpolates between the positions itself
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void draw(float interpolation);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            std::vector<SceneSnapshot::Sprite>& m_sprites;
+
+            unsigned int m_image;
+            sf::Vector2f m_size;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_SFML_SNAPSHOT_ENTITY_REPRESENTATION_HPP
@@ -27,7 +27,15 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <SFML/Graphics.hpp>
 #include <SpaceInvaders/View/AbstractView.hpp>
+#include <SpaceInvaders/View/Hud.hpp>
+#include <SpaceInvaders/View/SFMLBunkerRepresentation.hpp>
+#include <SpaceInvaders/View/SceneSnapshot.hpp>
+#include <SpaceInvaders/View/TextureAtlas.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -43,14 +51,35 @@ namespace Game
         {
         public:
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief How the entities are drawn
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            enum class RenderMode
+            {
+                Batched,  ///< All entities are drawn at once with a texture atlas
+                Threaded  ///< Like Batched, but a render thread draws snapshots that the draw function publishes
+            };
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Constructor to initialize the view
             ///
-            /// @param gameState State of the game
-            /// @param score     Current score to be displayed
+            /// @param gameState   State of the game
+            /// @param score       Current score to be displayed
+            /// @param renderMode  How the entities are drawn
+            /// @param tickTime    Duration of a tick of the game logic, the render thread uses it to keep
+            ///                    interpolating between ticks. Zero when the game doesn't use fixed ticks.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            SFMLView(GameState gameState, unsigned int score, RenderMode renderMode = RenderMode::Batched, sf::Time tickTime = sf::Time::Zero);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Destructor, stops the render thread
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            SFMLView(GameState gameState, unsigned int score);
+            ~SFMLView();
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -65,6 +94,10 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Poll the events from the sfml window and send messages to anyone interested
             ///
+            /// Besides the game controls, F3 toggles the profiler overlay and F4 writes the profiler
+            /// results to Profile.csv. The timings are only measured while the overlay is shown or after
+            /// F4 was pressed once, the second press of F4 writes them.
+            ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
             void handleEvents();
 
@@ -72,6 +105,9 @@ namespace Game
             ////////////////////////////////////////////////////////////////////////////////////////////////
             /// @brief Draw the current game screen on the window
             ///
+            /// With the threaded render mode, this only publishes a snapshot for the render thread and only
+            /// when something changed since the previous call.
+            ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
             void draw();
 
@@ -92,9 +128,81 @@ namespace Game
             void removeMessage();
 
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Remove the entities of the current level while keeping the window and its resources
+            ///
+            /// @param gameState  State of the game
+            /// @param score      Current score to be displayed
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void resetScene(GameState gameState, unsigned int score);
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
         private:
 
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Draw all entity representations on the window.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void drawEntities();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Draw the hud and when requested the profiler on top of the entities.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void drawOverlays(GameState gameState, const HudState& hudState, bool showProfiler);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Fill the write buffer of the snapshots and publish it to the render thread.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void publishSnapshot();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // The function running on the render thread and the one that draws a snapshot in it.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void render();
+            void drawSnapshot(const SceneSnapshot& snapshot);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Let the render thread finish its frame and wait for it, does nothing when it isn't running.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void stopRenderThread();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Create the function with which a bunker draws its cells in the current render mode.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            SFMLBunkerRepresentation::DrawRectFunction createDrawRectFunction(const std::string& filename);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Return the index of an image in the images of the snapshots, adding it when needed.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            unsigned int getImageId(const std::string& filename);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Draw the timings of the profiler on top of the game.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void drawProfiler();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Show or hide the profiler overlay, the timings are measured while it is shown.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void toggleProfiler();
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            // Start measuring the timings, or write them to Profile.csv when they are already measured.
+            // The result is shown as a message instead of ending the game when the file can't be written.
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void writeProfile();
+
+
             ////////////////////////////////////////////////////////////////////////////////////////////////
             // Callback function for when the score is changed.
             ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,13 +221,36 @@ namespace Game
 
             GameState m_gameState;
 
-            sf::Font m_font;
-            sf::Text m_score;
-            sf::Text m_lives;
-            sf::Text m_message;
+            // The hud can only be created once the font is loaded.
+            // The values are kept separately, so that they can be passed to the render thread.
+            sf::Font             m_font;
+            std::unique_ptr<Hud> m_hud;
+            HudState             m_hudState;
+
+            std::shared_ptr<const sf::Texture> m_backgroundTexture;
+            sf::Sprite m_backgroundSprite;
+
+            RenderMode      m_renderMode;
+            TextureAtlas    m_atlas;
+            sf::VertexArray m_vertices;
+
+            // Only used with the threaded render mode. The render thread owns the window, the atlas, the
+            // vertices, the hud and the profiler texts while it runs, it only gets the rest through snapshots.
+            sf::Time                                         m_tickTime;
+            SnapshotBuffer<SceneSnapshot>                    m_snapshots;
+            std::vector<SceneSnapshot::Sprite>               m_sprites;
+            std::shared_ptr<const std::vector<std::string>>  m_images;
+            std::unordered_map<std::string, unsigned int>    m_imageIds;
+            std::vector<sf::FloatRect>                       m_imageRects;
+            std::thread                                      m_renderThread;
+            std::atomic<bool>                                m_rendering{false};
 
-            sf::Texture m_backgroundTexture;
-            sf::Sprite  m_backgroundSprite;
+            // The overlay text is only rebuilt a few times per second, so that it stays readable
+            bool               m_showProfiler = false;
+            bool               m_measuringProfile = false; // F4 was pressed once, the timings are measured for the CSV file
+            sf::Text           m_profilerText;
+            sf::RectangleShape m_profilerBackground;
+            sf::Clock          m_profilerClock;
         };
     }
 }
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef SPACE_INVADERS_SCENE_SNAPSHOT_HPP
+#define SPACE_INVADERS_SCENE_SNAPSHOT_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <SpaceInvaders/Global.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Values shown by the hud
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct HudState
+        {
+            unsigned int score = 0;
+            unsigned int lives = 0;
+            bool         livesVisible = false;
+            std::string  message;
+        };
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Everything that is needed to draw one tick of the game without looking at the entities
+        ///
+        /// The simulation thread fills a snapshot after a tick and the render thread keeps drawing it,
+        /// interpolating between the previous and current positions, until a newer one is published.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        struct SceneSnapshot
+        {
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Transform of a visible entity
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            struct Sprite
+            {
+                unsigned int image; ///< Index in the images list of the snapshot
+                sf::Vector2f previousPosition;
+                sf::Vector2f currentPosition;
+                sf::Vector2f size;
+            };
+
+            std::vector<Sprite> sprites;
+
+            /// Filenames of the images, this list only grows and is shared between snapshots
+            std::shared_ptr<const std::vector<std::string>> images;
+
+            GameState gameState = GameState::MainMenu;
+            HudState  hud;
+            bool      showProfiler = false;
+
+            /// Interpolation at the moment the snapshot was published and when that was, so that the render
+            /// thread can keep moving the entities until the next tick. A zero tick time means no interpolation.
+            float interpolation = 1;
+            float tickTime = 0;
+            std::chrono::steady_clock::time_point publishTime;
+        };
+
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Hands values from one producer thread to one consumer thread without locking
+        ///
+        /// There are three buffers: the one being written, the one being read and the latest published one
+        /// in between. Publishing and fetching just swap a buffer with the one in between, so neither side ever
+        /// waits for the other. The producer may skip snapshots that the consumer never sees, the consumer
+        /// keeps reading the same snapshot until a newer one was published.
+        ///
+        /// Buffers are reused, so vectors inside them stop allocating once they have grown large enough.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        template <typename T>
+        class SnapshotBuffer
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the buffer that the producer fills before calling publish
+            ///
+            /// The buffer contains an older snapshot, it has to be completely overwritten.
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            T& getWriteBuffer()
+            {
+                return m_buffers[m_write];
+            }
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Make the write buffer available to the consumer and get another one to write in
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            void publish()
+            {
+                m_write = m_middle.exchange(m_write | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+            }
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Let the consumer switch to the latest published buffer
+            ///
+            /// @return Whether a buffer was published since the previous call
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            bool fetch()
+            {
+                if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0)
+                    return false;
+
+                m_read = m_middle.exchange(m_read, std::memory_order_acq_rel) & INDEX_MASK;
+                return true;
+            }
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the buffer that the consumer fetched last
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const T& getReadBuffer() const
+            {
+                return m_buffers[m_read];
+            }
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+
+            // The index of the buffer in between is stored together with a bit telling whether it was
+            // published after the consumer fetched a buffer
+            static const unsigned int FRESH = 4;
+            static const unsigned int INDEX_MASK = 3;
+
+            T m_buffers[3];
+
+            unsigned int m_write = 0;
+            unsigned int m_read = 1;
+            std::atomic<unsigned int> m_middle{2};
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_SCENE_SNAPSHOT_HPP
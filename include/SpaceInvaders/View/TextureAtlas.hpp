@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPACE_INVADERS_TEXTURE_ATLAS_HPP
+#define SPACE_INVADERS_TEXTURE_ATLAS_HPP
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <map>
+#include <SFML/Graphics.hpp>
+#include <SpaceInvaders/Global.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Packs multiple images into a single texture
+        ///
+        /// Everything that uses the atlas can be drawn with the same texture, so it can be drawn at once.
+        /// The images are placed next to each other in rows (shelves) of a limited width.
+        ///
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+        class TextureAtlas
+        {
+        public:
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Add an image to the atlas
+            ///
+            /// @param filename  Filename of the image
+            ///
+            /// @return The part of the atlas texture that contains the image
+            ///
+            /// When the image was already added then it will not be loaded again.
+            /// Parts that were returned earlier remain valid when the atlas grows.
+            ///
+            /// @exception std::runtime_error when the image could not be loaded
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            sf::IntRect addImage(const std::string& filename);
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            /// @brief Return the texture that contains all images
+            ///
+            /// @return Texture of the atlas
+            ///
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+            const sf::Texture& getTexture() const;
+
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        private:
+            sf::Image   m_image;
+            sf::Texture m_texture;
+
+            std::map<std::string, sf::IntRect> m_imageRects;
+
+            unsigned int m_shelfLeft = 0;
+            unsigned int m_shelfTop = 0;
+            unsigned int m_shelfHeight = 0;
+        };
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SPACE_INVADERS_TEXTURE_ATLAS_HPP
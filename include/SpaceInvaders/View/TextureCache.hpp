@@ -22,13 +22,14 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-#ifndef SPACE_INVADERS_SFML_ENTITY_REPRESENTATION_HPP
-#define SPACE_INVADERS_SFML_ENTITY_REPRESENTATION_HPP
+
+#ifndef SPACE_INVADERS_TEXTURE_CACHE_HPP
+#define SPACE_INVADERS_TEXTURE_CACHE_HPP
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#include <SpaceInvaders/Event.hpp>
-#include <SpaceInvaders/View/AbstractEntityRepresentation.hpp>
+#include <SFML/Graphics.hpp>
+#include <SpaceInvaders/Global.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -37,50 +38,47 @@ namespace Game
     namespace View
     {
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        /// @brief Class for displaying an entity with SFML
+        /// @brief Process-wide cache of textures, so that every image is only loaded once
+        ///
+        /// All users of the same image share the same texture. The cache keeps a reference to every texture,
+        /// the textures that are no longer used by anyone else are only freed when removeUnusedTextures is called.
         ///
         ////////////////////////////////////////////////////////////////////////////////////////////////////
-        class SFMLEntityRepresentation : public AbstractEntityRepresentation
+        class TextureCache
         {
         public:
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// @brief Constructor to initialize the entity representation
+            /// @brief Return the texture of an image, the image is loaded when it isn't cached yet
+            ///
+            /// @param filename  Filename of the image
+            ///
+            /// @return The shared texture
             ///
-            /// @param renderTarget Target on which the entity image will be drawn
-            /// @param entity       The entity to display
+            /// @exception std::runtime_error when the image could not be loaded
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            SFMLEntityRepresentation(sf::RenderTarget& renderTarget, EntityPtr entity);
+            static std::shared_ptr<const sf::Texture> getTexture(const std::string& filename);
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            /// @brief Draw the entity on the screen
+            /// @brief Free all textures that are not being used outside the cache
             ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            void draw();
-
-
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-        private:
+            static void removeUnusedTextures();
 
 
             ////////////////////////////////////////////////////////////////////////////////////////////////
-            // Callback function for when the position of the entity is changed
-            ////////////////////////////////////////////////////////////////////////////////////////////////
-            void positionChanged(const Event& event);
-
-
+            /// @brief Return the amount of textures that are currently loaded
+            ///
+            /// @return Amount of cached textures
+            ///
             ////////////////////////////////////////////////////////////////////////////////////////////////
-        private:
-            sf::Texture m_texture;
-            sf::Sprite  m_sprite;
-
-            sf::RenderTarget& m_renderTarget;
+            static std::size_t getTextureCount();
         };
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#endif // SPACE_INVADERS_SFML_ENTITY_REPRESENTATION_HPP
+#endif // SPACE_INVADERS_TEXTURE_CACHE_HPP
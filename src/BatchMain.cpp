@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <iostream>
+#include <string>
+#include <SpaceInvaders/BatchRunner.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        unsigned int games = 1000;
+        std::uint64_t firstSeed = 1;
+        unsigned int threads = 0;
+        unsigned int maxMinutes = 30;
+        Game::HeadlessClient::PlayerType playerType = Game::HeadlessClient::PlayerType::AI;
+
+        if (argc > 1)
+            games = std::stoul(argv[1]);
+        if (argc > 2)
+            firstSeed = std::stoull(argv[2]);
+        if (argc > 3)
+            threads = std::stoul(argv[3]);
+        if (argc > 4)
+        {
+            if (std::string(argv[4]) == "scripted")
+                playerType = Game::HeadlessClient::PlayerType::Scripted;
+            else if (std::string(argv[4]) != "ai")
+                argc = 0;
+        }
+
+        if ((argc > 5) || (argc == 0))
+        {
+            std::cout << "Usage: " << argv[0] << " [games] [first seed] [threads] [ai|scripted]" << std::endl;
+            return 1;
+        }
+
+        const Game::BatchRunner runner{threads};
+        const unsigned int maxTicks = maxMinutes * 60 * Game::TICKS_PER_SECOND;
+
+        sf::Clock clock;
+        const auto results = runner.run(games, firstSeed, playerType, maxTicks, sf::seconds(1.0f / Game::TICKS_PER_SECOND));
+        const float elapsedSeconds = clock.getElapsedTime().asSeconds();
+
+        const Game::BatchSummary summary = Game::BatchRunner::summarize(results);
+
+        std::cout << "Played " << summary.games << " games on " << runner.getThreadCount() << " threads in " << elapsedSeconds << "s" << std::endl;
+        std::cout << "Games lost: " << summary.gamesLost << " (the others were stopped after " << maxMinutes << " minutes)" << std::endl;
+        std::cout << "Score:    mean " << summary.meanScore << ", min " << summary.minScore << ", max " << summary.maxScore << std::endl;
+        std::cout << "Level:    mean " << summary.meanLevel << ", min " << summary.minLevel << ", max " << summary.maxLevel << std::endl;
+        std::cout << "Survival: mean " << summary.meanSurvival << "s, min " << summary.minSurvival << "s, max " << summary.maxSurvival << "s" << std::endl;
+        return 0;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception trown: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cout << "Unknown exception trown." << std::endl;
+        return 1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
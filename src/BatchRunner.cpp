@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <SpaceInvaders/BatchRunner.hpp>
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    BatchRunner::BatchRunner(unsigned int threadCount) :
+        m_threadCount(threadCount)
+    {
+        // hardware_concurrency is allowed to return 0 when the amount of cores can't be determined
+        if (m_threadCount == 0)
+            m_threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::vector<GameResult> BatchRunner::run(unsigned int games, std::uint64_t firstSeed, HeadlessClient::PlayerType playerType,
+                                             unsigned int maxTicks, const sf::Time& tickTime) const
+    {
+        // Every game writes its result in its own slot, so the threads only have to share the game counter
+        std::vector<GameResult> results(games);
+        std::atomic<unsigned int> nextGame{0};
+
+        // An exception can't leave a thread, so the first one is kept and thrown again after joining
+        std::exception_ptr error;
+        std::mutex errorMutex;
+
+        auto playGames = [&]()
+        {
+            try
+            {
+                for (unsigned int game = nextGame++; game < games; game = nextGame++)
+                {
+                    HeadlessClient client{firstSeed + game, playerType};
+                    results[game] = client.playGame(maxTicks, tickTime);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{errorMutex};
+                if (!error)
+                    error = std::current_exception();
+
+                // The other threads don't start new games once they finish their current one
+                nextGame = games;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        const unsigned int threadCount = std::min(m_threadCount, games);
+        for (unsigned int i = 1; i < threadCount; ++i)
+            threads.emplace_back(playGames);
+
+        // The calling thread plays games as well instead of only waiting
+        playGames();
+
+        for (auto& thread : threads)
+            thread.join();
+
+        if (error)
+            std::rethrow_exception(error);
+
+        return results;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    unsigned int BatchRunner::getThreadCount() const
+    {
+        return m_threadCount;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    BatchSummary BatchRunner::summarize(const std::vector<GameResult>& results)
+    {
+        BatchSummary summary;
+        if (results.empty())
+            return summary;
+
+        summary.games = results.size();
+        summary.minScore = results.front().score;
+        summary.minLevel = results.front().level;
+        summary.minSurvival = results.front().survivalTime.asSeconds();
+
+        for (auto& result : results)
+        {
+            const double survival = result.survivalTime.asSeconds();
+
+            if (result.gameOver)
+                summary.gamesLost++;
+
+            summary.meanScore += result.score;
+            summary.minScore = std::min(summary.minScore, result.score);
+            summary.maxScore = std::max(summary.maxScore, result.score);
+
+            summary.meanLevel += result.level;
+            summary.minLevel = std::min(summary.minLevel, result.level);
+            summary.maxLevel = std::max(summary.maxLevel, result.level);
+
+            summary.meanSurvival += survival;
+            summary.minSurvival = std::min(summary.minSurvival, survival);
+            summary.maxSurvival = std::max(summary.maxSurvival, survival);
+        }
+
+        summary.meanScore /= summary.games;
+        summary.meanLevel /= summary.games;
+        summary.meanSurvival /= summary.games;
+        return summary;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <SpaceInvaders/Collision.hpp>
+#include <SpaceInvaders/Controller/Controller.hpp>
+#include <SpaceInvaders/View/NullView.hpp>
+#include <SpaceInvaders/Model/EntityStore.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    using namespace Game;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    // From the amount of entities in a normal level up to a lot more than the screen can show
+    const std::vector<unsigned int> ENTITY_COUNTS = {40, 400, 4000, 40000};
+
+    // Amount of bullets that are used to check for collisions, they are used over and over again
+    const unsigned int PROBE_COUNT = 1024;
+
+    // The size of the bullets that are fired in the benchmarks
+    const Vector2f BULLET_SIZE = Vector2f{1.0f / 120.0f * SCREEN_WIDTH, 1.0f / 40.0f * SCREEN_HEIGHT};
+
+    // The time that passes during a single update
+    const sf::Time TICK_TIME = sf::seconds(1.0f / TICKS_PER_SECOND);
+
+    // The operation that is measured, the state that it needs is created before measuring starts
+    typedef std::function<void()> Operation;
+    typedef std::function<Operation(unsigned int entityCount)> Setup;
+
+    struct Benchmark
+    {
+        std::string name;
+        std::vector<unsigned int> entityCounts;
+        Setup setup;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Model::Gun createBenchGun(float bulletSpeed, const sf::Time& coolDownTime, float chanceIncrease)
+    {
+        return Model::Gun{"Resources/Bullet.png", BULLET_SIZE, bulletSpeed, coolDownTime, chanceIncrease};
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Spread the enemies over the top part of the screen, the more enemies the smaller they get
+    AttackingEntityList createEnemies(unsigned int count, float speed, float fireChance)
+    {
+        const auto columns = static_cast<unsigned int>(std::ceil(std::sqrt(count * 4.0f)));
+        const float spacing = static_cast<float>(SCREEN_WIDTH) / columns;
+
+        AttackingEntityList enemies;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            enemies.push_back(AttackingEntityPtr{new Model::EnemyEntity{"Resources/Enemy1.png", createBenchGun(250, sf::Time::Zero, fireChance), 5}});
+            enemies.back()->setSize(Vector2f{spacing * 0.875f, spacing * 0.875f});
+            enemies.back()->setSpeed(speed);
+            enemies.back()->setPosition(Vector2f{spacing * (i % columns), 50 + spacing * (i / columns)});
+        }
+
+        return enemies;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Put the wall blocks in rows above the player, the more walls the smaller they get
+    EntityList createWalls(unsigned int count)
+    {
+        const auto columns = static_cast<unsigned int>(std::ceil(std::sqrt(count * 8.0f)));
+        const float width = static_cast<float>(SCREEN_WIDTH) / columns;
+
+        EntityList walls;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            walls.push_back(EntityPtr{new Model::WallEntity{"Resources/Wall.png"}});
+            walls.back()->setSize(Vector2f{width, width / 2});
+            walls.back()->setPosition(Vector2f{width * (i % columns), 450 + (width / 2) * (i / columns)});
+        }
+
+        return walls;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Bullets at random places on the screen that never hit any of the entities. A hit would remove the
+    // entity, so the probes would find less and less entities as the benchmark goes on and the result would
+    // depend on the amount of iterations. Like in the game most of the checks are misses, but what is
+    // measured is only the cost of a check that finds nothing.
+    template <typename T>
+    std::vector<EntityPtr> createProbes(const std::vector<std::shared_ptr<T>>& entities)
+    {
+        std::vector<FloatRect> obstacles;
+        for (const auto& entity : entities)
+            obstacles.push_back(entity->getBounds());
+
+        Random random{PROBE_COUNT};
+
+        std::vector<EntityPtr> probes;
+        while (probes.size() < PROBE_COUNT)
+        {
+            const FloatRect bounds{random.nextFloat(0, SCREEN_WIDTH), random.nextFloat(0, SCREEN_HEIGHT), BULLET_SIZE.x, BULLET_SIZE.y};
+            if (std::any_of(obstacles.begin(), obstacles.end(), [&bounds](const FloatRect& obstacle){ return Collision::overlaps(bounds, obstacle); }))
+                continue;
+
+            probes.push_back(EntityPtr{new Model::BulletEntity{"Resources/Bullet.png", -350}});
+            probes.back()->setSize(BULLET_SIZE);
+            probes.back()->setPosition(Vector2f{bounds.left, bounds.top});
+        }
+
+        return probes;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Level with the normal amount of enemies and walls that stand still and never fire.
+    // The gun of the player has no cooldown and its bullets move so slowly that adding their movement to their
+    // position doesn't change it, so they stay where they are fired.
+    class BenchEntityFactory final : public AbstractEntityFactory
+    {
+        AttackingEntityList createEnemies(unsigned int)
+        {
+            return ::createEnemies(40, 0, 0);
+        }
+
+        EntityList createWalls(unsigned int)
+        {
+            return ::createWalls(60);
+        }
+
+        AttackingEntityPtr createPlayer(unsigned int)
+        {
+            auto player = std::shared_ptr<Model::PlayerEntity>(new Model::PlayerEntity{"Resources/Player.png", createGun(0, GunType::Normal)});
+            player->setLives(3);
+            player->setSize(Vector2f{2.0f / 20.0f * SCREEN_WIDTH, 5.0f / 80.0f * SCREEN_HEIGHT});
+            player->setPosition(Vector2f{(SCREEN_WIDTH - player->getSize().x) / 2.0f, SCREEN_HEIGHT - (player->getSize().y * (3.0f / 2.0f))});
+            return player;
+        }
+
+        Model::Gun createGun(unsigned int, GunType)
+        {
+            // The gun fires when the time since the last shot is larger than the cooldown, which is always
+            // the case with a negative cooldown, even when no time passes between the shots
+            return createBenchGun(-0.000001f, sf::microseconds(-1), 0);
+        }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Operation setupEnemyCollision(unsigned int entityCount)
+    {
+        struct State
+        {
+            View::NullView view;
+            Model::EntityStore store;
+            std::unique_ptr<Controller::EnemyController> controller;
+            std::vector<EntityPtr> probes;
+            std::size_t nextProbe = 0;
+        };
+
+        const AttackingEntityList enemies = createEnemies(entityCount, 20, 80);
+
+        auto state = std::make_shared<State>();
+        state->probes = createProbes(enemies);
+        state->controller.reset(new Controller::EnemyController{enemies, &state->view, state->store, Random{1}});
+
+        return [state]()
+        {
+            state->controller->checkCollision(state->probes[state->nextProbe++ % PROBE_COUNT]->getBounds());
+        };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Operation setupWallCollision(unsigned int entityCount)
+    {
+        struct State
+        {
+            View::NullView view;
+            Model::EntityStore store;
+            std::unique_ptr<Controller::WallController> controller;
+            std::vector<EntityPtr> probes;
+            std::size_t nextProbe = 0;
+        };
+
+        const EntityList walls = createWalls(entityCount * 3 / 2);
+
+        auto state = std::make_shared<State>();
+        state->probes = createProbes(walls);
+        state->controller.reset(new Controller::WallController{walls, BunkerList(), &state->view, state->store});
+
+        return [state]()
+        {
+            state->controller->checkCollision(state->probes[state->nextProbe++ % PROBE_COUNT]->getBounds());
+        };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Operation setupNotifyObservers(unsigned int observerCount)
+    {
+        // Observable can't be notified from outside
+        struct Subject : public Observable
+        {
+            void notify(const Event& event)
+            {
+                notifyObservers(event);
+            }
+        };
+
+        struct State
+        {
+            Subject subject;
+            unsigned int calls = 0;
+        };
+
+        auto state = std::make_shared<State>();
+        unsigned int& calls = state->calls;
+        for (unsigned int i = 0; i < observerCount; ++i)
+        {
+            state->subject.addObserver([&calls](const Event&){ ++calls; }, Event::Type::PositionChanged);
+
+            // Observers of other events should not slow down the notification
+            state->subject.addObserver([&calls](const Event&){ ++calls; }, Event::Type::SizeChanged);
+        }
+
+        return [state]()
+        {
+            state->subject.notify(Event{Event::Type::PositionChanged});
+        };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Operation setupEnemyUpdate(unsigned int entityCount)
+    {
+        struct State
+        {
+            View::NullView view;
+            Model::EntityStore store;
+            std::unique_ptr<Controller::EnemyController> controller;
+        };
+
+        auto state = std::make_shared<State>();
+        state->controller.reset(new Controller::EnemyController{createEnemies(entityCount, 20, 80), &state->view, state->store, Random{1}});
+
+        return [state]()
+        {
+            state->controller->update(TICK_TIME);
+        };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    // updateBullets is private, so the whole update is measured and the benchmark is named after it.
+    // Everything else in the level is constant and small, so the difference between the bullet counts
+    // is caused by updateBullets.
+    Operation setupBulletUpdate(unsigned int bulletCount)
+    {
+        struct State
+        {
+            View::NullView view;
+            std::unique_ptr<Controller::Controller> controller;
+        };
+
+        auto state = std::make_shared<State>();
+        state->controller.reset(new Controller::Controller{&state->view, 1, Random{1}, std::unique_ptr<AbstractEntityFactory>{new BenchEntityFactory{}}});
+
+        // Find the player and the space between the bottom of the enemies and the top of the walls
+        const Model::EntityStore& store = state->controller->getEntityStore();
+        Model::Entity* player = nullptr;
+        float enemiesBottom = 0;
+        float wallsTop = SCREEN_HEIGHT;
+        for (EntityId id = 0; id < store.getIdCount(); ++id)
+        {
+            if (!store.getAlive()[id])
+                continue;
+
+            const FloatRect bounds = store.getBounds(id);
+            if (store.getTypes()[id] == EntityType::Player)
+                player = store.getEntities()[id];
+            else if (store.getTypes()[id] == EntityType::Enemy)
+                enemiesBottom = std::max(enemiesBottom, bounds.top + bounds.height);
+            else if (store.getTypes()[id] == EntityType::Wall)
+                wallsTop = std::min(wallsTop, bounds.top);
+        }
+
+        // Let the player fire from random places in that space, so that none of the bullets hit anything.
+        // The bullet is fired from the middle of the player, so the player is moved up by the difference.
+        const float playerOffset = (player->getSize().y - BULLET_SIZE.y) / 2.0f;
+        Random random{bulletCount};
+        for (unsigned int i = 0; i < bulletCount; ++i)
+        {
+            player->setPosition(Vector2f{random.nextFloat(0, SCREEN_WIDTH - player->getSize().x),
+                                         random.nextFloat(enemiesBottom, wallsTop - BULLET_SIZE.y) - playerOffset});
+            state->view.queueEvent(Event{Event::Type::FireKeyPressed});
+            state->view.queueEvent(Event{Event::Type::FireKeyReleased});
+            state->view.handleEvents();
+        }
+
+        return [state]()
+        {
+            state->controller->update(TICK_TIME);
+        };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    // Time a number of iterations of the operation
+    double measure(const Operation& operation, std::uint64_t iterations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t i = 0; i < iterations; ++i)
+            operation();
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void run(const Benchmark& benchmark, unsigned int entityCount, double minSeconds, unsigned int rounds)
+    {
+        // Creating and destroying tens of thousands of entities takes a while, so all rounds share the same state
+        const Operation operation = benchmark.setup(entityCount);
+
+        // Find out how many iterations are needed to run for long enough
+        std::uint64_t iterations = 1;
+        double seconds = measure(operation, iterations);
+        while ((seconds < minSeconds / 10) && (iterations < 1000000000))
+        {
+            iterations *= 10;
+            seconds = measure(operation, iterations);
+        }
+        iterations = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(iterations * minSeconds / std::max(seconds, 1e-9)));
+
+        std::vector<double> nanoseconds;
+        for (unsigned int round = 0; round < rounds; ++round)
+            nanoseconds.push_back(measure(operation, iterations) * 1e9 / iterations);
+
+        std::sort(nanoseconds.begin(), nanoseconds.end());
+        std::cout << benchmark.name << ',' << entityCount << ',' << iterations << ','
+                  << nanoseconds.front() << ',' << nanoseconds[nanoseconds.size() / 2] << std::endl;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::string filter;
+        double minSeconds = 0.2;
+        unsigned int rounds = 5;
+
+        if (argc > 1)
+            filter = argv[1];
+        if (argc > 2)
+            minSeconds = std::stod(argv[2]);
+        if (argc > 3)
+            rounds = std::stoul(argv[3]);
+
+        if ((argc > 4) || (minSeconds <= 0) || (rounds == 0))
+        {
+            std::cerr << "Usage: " << argv[0] << " [filter] [seconds per round] [rounds]" << std::endl;
+            return 1;
+        }
+
+        // The amount of entities is the amount of enemies, the walls are 1.5 times as much (like 40 and 60 in a
+        // normal level). For notifyObservers it is the amount of observers and for Controller::update the amount of bullets.
+        const std::vector<Benchmark> benchmarks = {
+            {"EnemyController::checkCollision", ENTITY_COUNTS, setupEnemyCollision},
+            {"WallController::checkCollision", ENTITY_COUNTS, setupWallCollision},
+            {"Observable::notifyObservers", {0, 1, 40, 400, 4000, 40000}, setupNotifyObservers},
+            {"EnemyController::update", ENTITY_COUNTS, setupEnemyUpdate},
+            {"Controller::update (bullets varied)", ENTITY_COUNTS, setupBulletUpdate}
+        };
+
+        std::cout << "benchmark,entities,iterations,min_ns_per_op,median_ns_per_op" << std::endl;
+        for (const auto& benchmark : benchmarks)
+        {
+            if (benchmark.name.find(filter) == std::string::npos)
+                continue;
+
+            for (const auto entityCount : benchmark.entityCounts)
+                run(benchmark, entityCount, minSeconds, rounds);
+        }
+
+        return 0;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Exception trown: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cerr << "Unknown exception trown." << std::endl;
+        return 1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
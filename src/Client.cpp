@@ -24,14 +24,42 @@
 
 #include <SpaceInvaders/Client.hpp>
 #include <SpaceInvaders/View/SFMLView.hpp>
+#include <SpaceInvaders/View/TextureCache.hpp>
 
 namespace Game
 {
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
     
-    Client::Client()
+    Client::Client(std::uint64_t seed, unsigned int ticksPerSecond, const std::string& recordingFilename, EntityFactoryCreator createFactory,
+                   bool renderThread, const std::vector<std::string>& levelOptions) :
+        m_random           (seed),
+        m_createFactory    (createFactory ? std::move(createFactory) : makeFactoryCreator(LevelEntityFactory{LEVEL_FILENAME})),
+        m_view             (new View::SFMLView{m_gameState, m_score,
+                                               renderThread ? View::SFMLView::RenderMode::Threaded : View::SFMLView::RenderMode::Batched,
+                                               (ticksPerSecond > 0) ? sf::seconds(1.0f / ticksPerSecond) : sf::Time::Zero}),
+        m_recordingFilename(recordingFilename)
     {
-        loadNextLevel(Event{Event::Type::LevelComplete});
+        if (ticksPerSecond > 0)
+            m_tickTime = sf::seconds(1.0f / ticksPerSecond);
+
+        if (!m_recordingFilename.empty())
+        {
+            m_recording = std::unique_ptr<InputRecording>(new InputRecording{seed, m_tickTime, levelOptions});
+
+            // The keys reach the player controller through the view, so they are recorded at the same place
+            const Event::Type keyEvents[] = { Event::Type::MoveLeftKeyPressed, Event::Type::MoveLeftKeyReleased,
+                                              Event::Type::MoveRightKeyPressed, Event::Type::MoveRightKeyReleased,
+                                              Event::Type::FireKeyPressed, Event::Type::FireKeyReleased };
+            for (const auto eventType : keyEvents)
+                m_view->addObserver([this](const Event& event){ m_recording->addInput(m_tick, event.type); }, eventType);
+        }
+
+        m_view->addObserver(std::bind(&Client::gameStateChanged, this, std::placeholders::_1), Event::Type::GameStateChanged);
+
+        // The program should quit when receiving the exit event
+        m_view->addObserver([this](const Event&){ m_running = false; }, Event::Type::ApplicationExit);
+
+        loadNextLevel();
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -44,37 +72,86 @@ namespace Game
         while (m_running)
         {
             if (m_gameState == GameState::Playing)
-                m_controller->update(clock.restart());
+            {
+                if (m_tickTime == sf::Time::Zero)
+                {
+                    m_view->tickStarted();
+                    m_controller->update(clock.restart());
+                    m_tick++;
+                }
+                else
+                    updateFixedTicks(clock.restart());
+            }
             else
                 clock.restart();
 
+            if (m_gameOver)
+                gameOver();
+            else if (m_levelComplete)
+                loadNextLevel();
+
             m_view->handleEvents();
             m_view->draw();
 
             sf::sleep(sf::milliseconds(1));
         }
+
+        if (m_recording)
+            saveRecording();
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
     
-    void Client::loadNextLevel(const Event&)
+    void Client::updateFixedTicks(const sf::Time& elapsedTime)
+    {
+        m_accumulatedTime += elapsedTime;
+
+        unsigned int ticks = 0;
+        while ((m_accumulatedTime >= m_tickTime) && (m_gameState == GameState::Playing) && !m_levelComplete && !m_gameOver)
+        {
+            // Don't try to catch up when we are too far behind, the game would only get slower
+            if (ticks == MAX_TICKS_PER_FRAME)
+            {
+                m_accumulatedTime = sf::microseconds(m_accumulatedTime.asMicroseconds() % m_tickTime.asMicroseconds());
+                break;
+            }
+
+            m_view->tickStarted();
+            m_controller->update(m_tickTime);
+            m_tick++;
+
+            m_accumulatedTime -= m_tickTime;
+            ticks++;
+        }
+
+        m_view->setInterpolation(m_accumulatedTime.asSeconds() / m_tickTime.asSeconds());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+    
+    void Client::loadNextLevel()
     {
         m_difficulty++;
+        m_levelComplete = false;
+        m_gameOver = false;
+        m_accumulatedTime = sf::Time::Zero;
 
-        m_view       = std::unique_ptr<View::AbstractView>(new View::SFMLView{m_gameState, m_score});
-        m_controller = std::unique_ptr<Controller::Controller>(new Controller::Controller{m_view.get(), m_difficulty});
+        // The entities have to be destroyed before their representations are removed from the view
+        m_controller = nullptr;
+        m_view->resetScene(m_gameState, m_score);
 
-        m_view->addObserver(std::bind(&Client::gameStateChanged, this, std::placeholders::_1), Event::Type::GameStateChanged);
+        // Every level plays out differently
+        m_controller = std::unique_ptr<Controller::Controller>(new Controller::Controller{m_view.get(), m_difficulty, m_random.split(), m_createFactory()});
 
-        // This function should be called again when the level is over
-        m_controller->addObserver(std::bind(&Client::loadNextLevel, this, std::placeholders::_1), Event::Type::LevelComplete);
+        // Free the images that were only used in the previous level
+        View::TextureCache::removeUnusedTextures();
 
-        // The program should quit when receiving the exit event
-        m_view->addObserver([this](const Event&){ m_running = false; }, Event::Type::ApplicationExit);
-        m_controller->addObserver(std::bind(&Client::gameOver, this, std::placeholders::_1), Event::Type::GameOver);
+        // Find out when the level is over, the main loop will then load the next one
+        m_controller->addObserver([this](const Event&){ m_levelComplete = true; }, Event::Type::LevelComplete);
+        m_controller->addObserver([this](const Event&){ m_gameOver = true; }, Event::Type::GameOver);
 
         // Increase the score when an enemy gets killed
-        m_controller->addObserver([this](const Event& event){ m_score += event.score; }, Event::Type::ScoreChanged);
+        m_controller->addObserver([this](const Event& event){ m_score += event.score; m_totalScore += event.score; }, Event::Type::ScoreChanged);
 
         // Let the view know the current score
         Event scoreEvent{Event::Type::ScoreChanged};
@@ -92,12 +169,22 @@ namespace Game
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
     
-    void Client::gameOver(const Event& event)
+    void Client::gameOver()
     {
         m_gameState = GameState::GameOver;
         m_difficulty = 0;
 
-        loadNextLevel(event);
+        loadNextLevel();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Client::saveRecording()
+    {
+        m_recording->finish(m_tick, m_totalScore);
+        m_recording->saveToFile(m_recordingFilename);
+
+        std::cout << "Recorded " << m_recording->getInputs().size() << " inputs during " << m_tick << " ticks to '" << m_recordingFilename << "'" << std::endl;
     }
     
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <limits>
+#include <SpaceInvaders/Collision.hpp>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define SPACE_INVADERS_COLLISION_AVX
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))
+    #include <xmmintrin.h>
+    #define SPACE_INVADERS_COLLISION_SSE
+#endif
+
+namespace Game
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const std::size_t PackedRects::BATCH_SIZE;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void PackedRects::clear()
+    {
+        m_lefts.clear();
+        m_tops.clear();
+        m_rights.clear();
+        m_bottoms.clear();
+        m_size = 0;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void PackedRects::push(const FloatRect& rect)
+    {
+        // Start a new batch filled with rectangles that can't overlap anything
+        if (m_size % BATCH_SIZE == 0)
+        {
+            const float infinity = std::numeric_limits<float>::infinity();
+            m_lefts.resize(m_size + BATCH_SIZE, infinity);
+            m_tops.resize(m_size + BATCH_SIZE, infinity);
+            m_rights.resize(m_size + BATCH_SIZE, -infinity);
+            m_bottoms.resize(m_size + BATCH_SIZE, -infinity);
+        }
+
+        m_lefts[m_size] = rect.left;
+        m_tops[m_size] = rect.top;
+        m_rights[m_size] = rect.left + rect.width;
+        m_bottoms[m_size] = rect.top + rect.height;
+        m_size++;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::size_t PackedRects::size() const
+    {
+        return m_size;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const float* PackedRects::getLefts() const
+    {
+        return m_lefts.data();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const float* PackedRects::getTops() const
+    {
+        return m_tops.data();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const float* PackedRects::getRights() const
+    {
+        return m_rights.data();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const float* PackedRects::getBottoms() const
+    {
+        return m_bottoms.data();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    namespace Collision
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        unsigned int overlapBatch(const FloatRect& rect, const PackedRects& rects, std::size_t first)
+        {
+            const float* lefts = rects.getLefts() + first;
+            const float* tops = rects.getTops() + first;
+            const float* rights = rects.getRights() + first;
+            const float* bottoms = rects.getBottoms() + first;
+
+            // The sides are calculated like in overlaps, so that all versions round the same way
+            const float right = rect.left + rect.width;
+            const float bottom = rect.top + rect.height;
+
+#if defined(SPACE_INVADERS_COLLISION_AVX)
+            const __m256 overlapX = _mm256_and_ps(_mm256_cmp_ps(_mm256_set1_ps(rect.left), _mm256_loadu_ps(rights), _CMP_LT_OQ),
+                                                  _mm256_cmp_ps(_mm256_loadu_ps(lefts), _mm256_set1_ps(right), _CMP_LT_OQ));
+            const __m256 overlapY = _mm256_and_ps(_mm256_cmp_ps(_mm256_set1_ps(rect.top), _mm256_loadu_ps(bottoms), _CMP_LT_OQ),
+                                                  _mm256_cmp_ps(_mm256_loadu_ps(tops), _mm256_set1_ps(bottom), _CMP_LT_OQ));
+
+            return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_and_ps(overlapX, overlapY)));
+
+#elif defined(SPACE_INVADERS_COLLISION_SSE)
+            const __m128 left4 = _mm_set1_ps(rect.left);
+            const __m128 top4 = _mm_set1_ps(rect.top);
+            const __m128 right4 = _mm_set1_ps(right);
+            const __m128 bottom4 = _mm_set1_ps(bottom);
+
+            // A batch is handled as two halves of four rectangles
+            unsigned int mask = 0;
+            for (unsigned int half = 0; half < 2; ++half)
+            {
+                const std::size_t i = half * 4;
+                const __m128 overlapX = _mm_and_ps(_mm_cmplt_ps(left4, _mm_loadu_ps(rights + i)), _mm_cmplt_ps(_mm_loadu_ps(lefts + i), right4));
+                const __m128 overlapY = _mm_and_ps(_mm_cmplt_ps(top4, _mm_loadu_ps(bottoms + i)), _mm_cmplt_ps(_mm_loadu_ps(tops + i), bottom4));
+
+                mask |= static_cast<unsigned int>(_mm_movemask_ps(_mm_and_ps(overlapX, overlapY))) << i;
+            }
+
+            return mask;
+
+#else
+            unsigned int mask = 0;
+            for (std::size_t i = 0; i < PackedRects::BATCH_SIZE; ++i)
+            {
+                if ((rect.left < rights[i]) && (lefts[i] < right) && (rect.top < bottoms[i]) && (tops[i] < bottom))
+                    mask |= 1u << i;
+            }
+
+            return mask;
+#endif
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const char* getInstructionSet()
+        {
+#if defined(SPACE_INVADERS_COLLISION_AVX)
+            return "AVX";
+#elif defined(SPACE_INVADERS_COLLISION_SSE)
+            return "SSE";
+#else
+            return "scalar";
+#endif
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
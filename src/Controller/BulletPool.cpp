@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <SpaceInvaders/Controller/BulletPool.hpp>
+#include <SpaceInvaders/View/AbstractView.hpp>
+
+namespace Game
+{
+    namespace Controller
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        BulletPool::BulletPool(View::AbstractView* view, Model::EntityStore& store) :
+            m_view (view),
+            m_store(store)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void BulletPool::reserve(const Model::Gun& gun, unsigned int count)
+        {
+            FreeList& freeList = getFreeList(gun.getBulletFilename(), gun.getBulletSize());
+
+            m_bullets.reserve(m_bullets.size() + count);
+            freeList.bullets.reserve(freeList.bullets.size() + count);
+
+            for (unsigned int i = 0; i < count; ++i)
+                createBullet(gun, freeList);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        BulletPtr BulletPool::acquire(const Model::Gun& gun, const Vector2f& position)
+        {
+            FreeList& freeList = getFreeList(gun.getBulletFilename(), gun.getBulletSize());
+            if (freeList.bullets.empty())
+                createBullet(gun, freeList);
+
+            BulletPtr bullet = std::move(freeList.bullets.back());
+            freeList.bullets.pop_back();
+
+            bullet->setSpeed(gun.getBulletSpeed());
+            bullet->setPosition(position);
+            bullet->setVisible(true);
+            return bullet;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void BulletPool::release(const BulletPtr& bullet)
+        {
+            bullet->setVisible(false);
+            getFreeList(bullet->getImageFilename(), bullet->getSize()).bullets.push_back(bullet);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::size_t BulletPool::getBulletCount() const
+        {
+            return m_bullets.size();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        BulletPool::FreeList& BulletPool::getFreeList(const std::string& filename, const Vector2f& size)
+        {
+            for (auto& freeList : m_freeLists)
+            {
+                if ((freeList.filename == filename) && (freeList.size.x == size.x) && (freeList.size.y == size.y))
+                    return freeList;
+            }
+
+            m_freeLists.push_back(FreeList{filename, size, {}});
+            return m_freeLists.back();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void BulletPool::createBullet(const Model::Gun& gun, FreeList& freeList)
+        {
+            BulletPtr bullet = BulletPtr{new Model::BulletEntity(gun.getBulletFilename(), gun.getBulletSpeed())};
+            bullet->setSize(gun.getBulletSize());
+            bullet->setVisible(false);
+            bullet->attachToStore(m_store);
+            m_view->addEntity(bullet);
+
+            m_bullets.push_back(bullet);
+            freeList.bullets.push_back(bullet);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -22,10 +22,12 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <map>
 #include <SpaceInvaders/Controller/Controller.hpp>
 #include <SpaceInvaders/Controller/Powerups.hpp>
 #include <SpaceInvaders/Factory/DebugEntityFactory.hpp>
 #include <SpaceInvaders/View/AbstractView.hpp>
+#include <SpaceInvaders/Profiler.hpp>
 
 namespace Game
 {
@@ -33,28 +35,42 @@ namespace Game
     {
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        Controller::Controller(View::AbstractView* view, unsigned int difficulty) :
-            m_difficulty      (difficulty),
+        Controller::Controller(View::AbstractView* view, unsigned int difficulty, Random random, std::unique_ptr<AbstractEntityFactory> factory) :
             m_view            (view),
-            m_factory         (new DebugEntityFactory()),
-            m_playerController(m_factory->createPlayer(difficulty), view),
-            m_enemyController (m_factory->createEnemies(difficulty), view),
-            m_wallController  (m_factory->createWalls(difficulty), view)
+            m_factory         (factory ? std::move(factory) : std::unique_ptr<AbstractEntityFactory>(new DebugEntityFactory())),
+            m_playerController(m_factory->createPlayer(difficulty), view, m_entityStore),
+            m_enemyController (m_factory->createEnemies(difficulty), view, m_entityStore, random.split()),
+            m_wallController  (m_factory->createWalls(difficulty), m_factory->createBunkers(difficulty), view, m_entityStore),
+            m_bulletPool      (view, m_entityStore)
         {
+            // Remember where the player has to return to when being hit
+            m_playerSpawnPosition = m_playerController.getPlayer()->getPosition();
+
+            // Create the bullets now so that no memory has to be allocated when a gun is fired
+            m_bulletPool.reserve(m_playerController.getPlayer()->getGun(), BULLET_POOL_SIZE);
+            if (!m_enemyController.getEnemies().empty())
+                m_bulletPool.reserve(m_enemyController.getEnemies().front()->getGun(), BULLET_POOL_SIZE);
+            m_bullets.reserve(2 * BULLET_POOL_SIZE);
+
+            // Some levels start with bullets that are already flying
+            createSpawnedBullets(difficulty);
+
             // We are responsible for creating the bullets (because it involves a factory)
             m_playerController.addObserver(std::bind(&Controller::createBullet, this, std::placeholders::_1), Event::Type::GunFired);
             m_enemyController.addObserver(std::bind(&Controller::createBullet, this, std::placeholders::_1), Event::Type::GunFired);
 
+            // Powerups are activated while looping over the bullets and deactivated while looping over the
+            // powerups, their events are queued so that the powerups don't change during those loops
+            m_enemyController.setEventQueueing(true);
+            m_powerupController.setEventQueueing(true);
+
             // We will also be handling the powerups
             m_enemyController.addObserver(std::bind(&Controller::powerupActivated, this, std::placeholders::_1), Event::Type::PowerupActivated);
             m_powerupController.addObserver(std::bind(&Controller::powerupDeactivated, this, std::placeholders::_1), Event::Type::PowerupDeactivated);
 
-            // We need to know when the enemy moves (if they get too low then the game should end) and when it dies (to keep track of the score)
+            // We need to know when an enemy dies (to keep track of the score)
             for (auto& enemy : m_enemyController.getEnemies())
-            {
-                enemy->addObserver(std::bind(&Controller::enemyMoved, this, std::placeholders::_1), Event::Type::PositionChanged);
                 enemy->addObserver(std::bind(&Controller::scoreChanged, this, std::placeholders::_1), Event::Type::ScoreChanged);
-            }
 
             // Find out when the player dies
             m_playerController.addObserver(std::bind(&Controller::livesChanged, this, std::placeholders::_1), Event::Type::LivesChanged);
@@ -71,10 +87,14 @@ namespace Game
             notifyObservers(event);
 
             // The enemies are not allowed to get below the defence walls
-            for (auto& wall : m_wallController.getWalls())
+            const auto& types = m_entityStore.getTypes();
+            const auto& entities = m_entityStore.getEntities();
+            const auto& positions = m_entityStore.getPositions();
+            const auto& sizes = m_entityStore.getSizes();
+            for (EntityId id = 0; id < m_entityStore.getIdCount(); ++id)
             {
-                if (wall->getPosition().y + wall->getSize().y > m_lowestEnemyPosition)
-                    m_lowestEnemyPosition = wall->getPosition().y + wall->getSize().y;
+                if (entities[id] && (types[id] == EntityType::Wall))
+                    m_lowestEnemyPosition = std::max(m_lowestEnemyPosition, positions[id].y + sizes[id].y);
             }
 
             // If there are no defence walls then the enemies can get until the player
@@ -87,77 +107,149 @@ namespace Game
         void Controller::update(const sf::Time& elapsedTime)
         {
             m_playerController.update(elapsedTime);
+
+            // The events of the enemies and powerups are handled in batches between the phases of the tick
             m_enemyController.update(elapsedTime);
+            m_enemyController.dispatchQueuedEvents();
+
             m_powerupController.update(elapsedTime);
+            m_powerupController.dispatchQueuedEvents();
 
             updateBullets(elapsedTime);
+            m_enemyController.dispatchQueuedEvents();
+
+            // Everything that was hit during this tick is only removed now that nobody is looping over it anymore
+            m_bulletQueue.flush(m_bullets, [this](const BulletPtr& bullet){ m_bulletPool.release(bullet); });
+            m_wallController.removeDestroyed();
+
+            // If all emenies are dead then the level is over
+            if ((m_enemyController.removeDestroyed() > 0) && m_enemyController.getEnemies().empty())
+            {
+                notifyObservers(Event{Event::Type::LevelComplete});
+                return;
+            }
+
+            if (m_playerHit)
+            {
+                playerHit();
+                return;
+            }
+
+            // If the enemies get too low then the game should end
+            const Model::Formation& formation = m_enemyController.getFormation();
+            if (!formation.isEmpty() && (formation.getBounds().top + formation.getBounds().height > m_lowestEnemyPosition))
+                notifyObservers(Event{Event::Type::GameOver});
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const Model::EntityStore& Controller::getEntityStore() const
+        {
+            return m_entityStore;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         void Controller::updateBullets(const sf::Time& elapsedTime)
         {
-            for (unsigned int i = 0; i < m_bullets.size();)
+            Profiler::ScopedTimer timer{Profiler::Phase::BulletUpdate};
+
+            // The position, size and speed of the bullets are read from the store
+            const auto& positions = m_entityStore.getPositions();
+            const auto& speeds = m_entityStore.getSpeeds();
+            const float elapsedSeconds = elapsedTime.asSeconds();
+
+            for (auto& bullet : m_bullets)
             {
+                const EntityId id = bullet->getStoreId();
+                const float speed = speeds[id];
+
                 // Update the position of the bullet
-                m_bullets[i]->setPosition(Vector2f{m_bullets[i]->getPosition().x,
-                                                   m_bullets[i]->getPosition().y + (m_bullets[i]->getSpeed() * elapsedTime.asSeconds())});
+                bullet->setPosition(Vector2f{positions[id].x, positions[id].y + (speed * elapsedSeconds)});
+                const FloatRect bounds = m_entityStore.getBounds(id);
 
                 // Check if the bullet collides with one of the entities
-                if (m_bullets[i]->getSpeed() < 0)
+                if (speed < 0)
                 {
-                    if ((m_wallController.checkCollision(m_bullets[i])) || (m_enemyController.checkCollision(m_bullets[i])))
+                    if ((m_wallController.checkCollision(bounds)) || (m_enemyController.checkCollision(bounds)))
                     {
-                        // If all emenies are dead then the level is over
-                        if (m_enemyController.getEnemies().empty())
-                        {
-                            notifyObservers(Event{Event::Type::LevelComplete});
-                            return;
-                        }
-
-                        m_bullets[i]->destroy();
-                        m_bullets.erase(m_bullets.begin()+i);
+                        m_bulletQueue.push(bullet.get());
                         continue;
                     }
                 }
-                else if (m_bullets[i]->getSpeed() > 0)
+                else if (speed > 0)
                 {
-                    if ((m_playerController.checkCollision(m_bullets[i])) || (m_wallController.checkCollision(m_bullets[i])))
+                    // The player can only be hit once per tick, all bullets are removed when it happens
+                    if ((!m_playerHit && m_playerController.checkCollision(bounds)) || (m_wallController.checkCollision(bounds)))
                     {
-                        if (m_bullets.empty())
-                            break;
-
-                        m_bullets[i]->destroy();
-                        m_bullets.erase(m_bullets.begin()+i);
+                        m_bulletQueue.push(bullet.get());
                         continue;
                     }
                 }
 
                 // Remove the bullet once it leaves the screen
-                if ((m_bullets[i]->getPosition().y > SCREEN_HEIGHT) || (m_bullets[i]->getPosition().y + m_bullets[i]->getSize().y < 0))
-                {
-                    m_bullets[i]->destroy();
-                    m_bullets.erase(m_bullets.begin()+i);
-                    continue;
-                }
-                else
-                    i++;
+                if ((bounds.top > SCREEN_HEIGHT) || (bounds.top + bounds.height < 0))
+                    m_bulletQueue.push(bullet.get());
             }
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        void Controller::livesChanged(const Event& event)
+        void Controller::createSpawnedBullets(unsigned int difficulty)
         {
-            // Reset the position of the player
-            event.entity->setPosition(m_factory->createPlayer(m_difficulty)->getPosition());
+            const BulletSpawnList spawns = m_factory->createBullets(difficulty);
+            if (spawns.empty())
+                return;
 
-            // Remove all bullets
+            // Every type of gun is only created once
+            std::map<GunType, Model::Gun> guns;
+
+            m_bullets.reserve(m_bullets.size() + spawns.size());
+            for (const auto& spawn : spawns)
+            {
+                auto it = guns.find(spawn.gun);
+                if (it == guns.end())
+                    it = guns.insert(std::make_pair(spawn.gun, m_factory->createGun(difficulty, spawn.gun))).first;
+
+                m_bullets.push_back(m_bulletPool.acquire(it->second, spawn.position));
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Controller::removeAllBullets()
+        {
             for (auto& bullet : m_bullets)
-                bullet->destroy();
+                m_bulletPool.release(bullet);
+
             m_bullets.clear();
+            m_bulletQueue.clear();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Controller::livesChanged(const Event&)
+        {
+            // The bullets are still being updated, so the player is only reset at the end of the tick
+            m_playerHit = true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Controller::playerHit()
+        {
+            m_playerHit = false;
+
+            // Reset the position of the player
+            AttackingEntityPtr& player = m_playerController.getPlayer();
+            player->setPosition(m_playerSpawnPosition);
+
+            // Remove all bullets
+            removeAllBullets();
 
             // Notify the others about the event
+            Event event{Event::Type::LivesChanged, player.get()};
+            event.lives = dynamic_cast<Model::PlayerEntity*>(player.get())->getLives();
             notifyObservers(event);
 
             // Stop the game when there are no more lives left
@@ -173,22 +265,21 @@ namespace Game
             {
                 case PowerupType::SpeedBoost:
                 {
-                    m_powerupController.addPowerup(PowerupPtr{new SpeedChangePowerup{m_playerController.getPlayer(), sf::seconds(10), 2.0f}});
+                    m_powerupController.addPowerup(PowerupPtr{new ModifierPowerup{m_playerController.getSpeedModifiers(), sf::seconds(10), 2.0f}});
 
                     m_view->setMessage("SpeedBoost");
                     break;
                 }
                 case PowerupType::Slowdown:
                 {
-                    for (auto& enemy : m_enemyController.getEnemies())
-                        m_powerupController.addPowerup(PowerupPtr{new SpeedChangePowerup{enemy, sf::seconds(5), 0.33f}});
+                    m_powerupController.addPowerup(PowerupPtr{new ModifierPowerup{m_enemyController.getSpeedModifiers(), sf::seconds(5), 0.33f}});
 
                     m_view->setMessage("Slowdown");
                     break;
                 }
                 case PowerupType::RapidFire:
                 {
-                    m_powerupController.addPowerup(PowerupPtr{new FireRatePowerup{m_playerController.getPlayer(), sf::seconds(3), 4.0f}});
+                    m_powerupController.addPowerup(PowerupPtr{new ModifierPowerup{m_playerController.getFireRateModifiers(), sf::seconds(3), 4.0f}});
 
                     m_view->setMessage("RapidFire");
                     break;
@@ -209,23 +300,10 @@ namespace Game
 
         void Controller::createBullet(const Event& event)
         {
-            Model::Gun gun = dynamic_cast<Model::AttackingEntity*>(event.entity)->getGun();
-
-            BulletPtr bullet = BulletPtr{new Model::BulletEntity(gun.getBulletFilename(), gun.getBulletSpeed())};
-            bullet->setSize(gun.getBulletSize());
-            bullet->setPosition(Vector2f{event.entity->getPosition().x + ((event.entity->getSize().x - bullet->getSize().x) / 2.0f),
-                                         event.entity->getPosition().y + ((event.entity->getSize().y - bullet->getSize().y) / 2.0f)});
-            m_view->addEntity(bullet);
-            m_bullets.push_back(bullet);
-        }
-
-        ////////////////////////////////////////////////////////////////////////////////////////////////////
+            const Model::Gun& gun = dynamic_cast<Model::AttackingEntity*>(event.entity)->getGun();
 
-        void Controller::enemyMoved(const Event& event)
-        {
-            // If one of the enemies gets too low then the game should end
-            if (event.position.y + event.entity->getSize().y > m_lowestEnemyPosition)
-                notifyObservers(Event{Event::Type::GameOver});
+            m_bullets.push_back(m_bulletPool.acquire(gun, Vector2f{event.entity->getPosition().x + ((event.entity->getSize().x - gun.getBulletSize().x) / 2.0f),
+                                                                   event.entity->getPosition().y + ((event.entity->getSize().y - gun.getBulletSize().y) / 2.0f)}));
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -241,9 +319,9 @@ namespace Game
 
         void Controller::gameOver(const Event&)
         {
-            m_bullets.clear();
-            m_wallController.getWalls().clear();
-            m_enemyController.getEnemies().clear();
+            removeAllBullets();
+            m_wallController.clear();
+            m_enemyController.clear();
             m_playerController.getPlayer() = nullptr;
             m_powerupController.getPowerups().clear();
         }
@@ -22,7 +22,10 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <algorithm>
+#include <cmath>
 #include <SpaceInvaders/Controller/EnemyController.hpp>
+#include <SpaceInvaders/Profiler.hpp>
 #include <SpaceInvaders/View/AbstractView.hpp>
 #include <SpaceInvaders/Model/Entities.hpp>
 
@@ -30,170 +33,260 @@ namespace Game
 {
     namespace Controller
     {
+        namespace
+        {
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+
+            // The grid contains the positions inside the formation, which don't change when it moves
+            FloatRect getLocalBounds(const Model::Entity* enemy)
+            {
+                return FloatRect{enemy->getLocalPosition().x, enemy->getLocalPosition().y, enemy->getSize().x, enemy->getSize().y};
+            }
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        }
+
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        EnemyController::EnemyController(AttackingEntityList enemies, View::AbstractView* view) :
-            m_enemies(enemies)
+        EnemyController::EnemyController(AttackingEntityList enemies, View::AbstractView* view, Model::EntityStore& store, Random random) :
+            m_enemies      (enemies),
+            m_store        (store),
+            m_fireRandom   (random.split()),
+            m_powerupRandom(random.split())
         {
             for (auto& enemy : m_enemies)
+            {
+                // The enemy has to be in the formation before the view gets it, so that it can follow the formation
+                enemy->joinFormation(m_formation);
                 view->addEntity(enemy);
+                enemy->attachToStore(store);
+
+                // Keep the grid up to date when the enemy moves inside the formation
+                m_grid.insert(enemy->getStoreId(), getLocalBounds(enemy.get()));
+                enemy->addObserver([this](const Event& event){ m_grid.move(event.entity->getStoreId(), getLocalBounds(event.entity)); },
+                                   Event::Type::PositionChanged);
+            }
+
+            createColumns();
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         void EnemyController::update(const sf::Time& elapsedTime)
         {
+            Profiler::ScopedTimer timer{Profiler::Phase::EnemyUpdate};
+
+            if (m_enemies.empty())
+                return;
+
+            m_time += elapsedTime;
             float elapsedSeconds = elapsedTime.asSeconds();
 
+            // All enemies move at the same speed, so the formation moves at the speed of any of them
+            float distance = std::abs(m_enemies.front()->getSpeed()) * m_speedModifiers.getFactor() * elapsedSeconds;
+            Vector2f offset = m_formation.getOffset();
+
             // Check if the movement is vertical
             if (m_movingDown)
             {
-                int reverseMovement = 0;
-
-                if (!m_enemies.empty())
-                    m_movingDownDistance += std::abs(m_enemies[0]->getSpeed()) * elapsedSeconds;
+                m_movingDownDistance += distance;
 
-                // Move all enemies depending on their speed
-                for (auto& enemy : m_enemies)
+                // If the formation has gone down far enough then it starts moving in the other direction
+                if (m_movingDownDistance > ENEMY_CHANGE_TOP_DIFF)
                 {
-                    float distanceDiff = std::abs(enemy->getSpeed()) * elapsedSeconds;
-
-                    if (m_movingDownDistance > ENEMY_CHANGE_TOP_DIFF)
-                        reverseMovement = m_movingDownDistance - ENEMY_CHANGE_TOP_DIFF;
-
-                    enemy->setPosition(Vector2f{enemy->getPosition().x, enemy->getPosition().y + distanceDiff});
-
-                    // If there are no more enemies then the game was ended
-                    if (m_enemies.empty())
-                        return;
-                }
+                    distance -= m_movingDownDistance - ENEMY_CHANGE_TOP_DIFF;
 
-                // If one of the enemies has gone too far then revert part of the movement and start moving in another direction
-                if (reverseMovement != 0)
-                {
                     m_movingDown = false;
-
-                    for (auto& enemy : m_enemies)
-                    {
-                        enemy->setPosition(Vector2f{enemy->getPosition().x, enemy->getPosition().y - reverseMovement});
-                        enemy->setSpeed(-enemy->getSpeed());
-                    }
+                    m_formation.setDirection(-m_formation.getDirection());
                 }
+
+                offset.y += distance;
             }
             else // The movement is horizontal
             {
-                int reverseMovement = 0;
+                const FloatRect bounds = m_formation.getBounds();
+                float movement = m_formation.getDirection() * distance;
 
-                // Move all enemies depending on their speed
-                for (auto& enemy : m_enemies)
+                // If the formation would move past the side of the screen then it only goes until the side and starts moving down
+                if ((movement > 0) && (bounds.left + bounds.width + movement > SCREEN_WIDTH))
                 {
-                    float distanceDiff = enemy->getSpeed() * elapsedSeconds;
-
-                    if (enemy->getSpeed() > 0)
-                    {
-                        if (enemy->getPosition().x + enemy->getSize().x + distanceDiff > SCREEN_WIDTH)
-                            reverseMovement = enemy->getPosition().x + enemy->getSize().x + distanceDiff - SCREEN_WIDTH;
-                    }
-                    else // The enemies are moving to the left
-                    {
-                        if (enemy->getPosition().x + distanceDiff < 0)
-                            reverseMovement = enemy->getPosition().x + distanceDiff;
-                    }
-
-                    enemy->setPosition(Vector2f{enemy->getPosition().x + distanceDiff, enemy->getPosition().y});
+                    movement = SCREEN_WIDTH - bounds.left - bounds.width;
+                    m_movingDown = true;
+                    m_movingDownDistance = 0;
                 }
-
-                // If one of the enemies has gone too far then revert part of the movement and start moving in another direction
-                if (reverseMovement != 0)
+                else if ((movement < 0) && (bounds.left + movement < 0))
                 {
+                    movement = -bounds.left;
                     m_movingDown = true;
                     m_movingDownDistance = 0;
-
-                    for (auto& enemy : m_enemies)
-                        enemy->setPosition(Vector2f{enemy->getPosition().x - reverseMovement, enemy->getPosition().y});
                 }
-            }
 
-            // Only the bottom enemy of every row can fire
-            std::map<int, AttackingEntityPtr> fireCapableEnemies;
-            for (auto& enemy : m_enemies)
-            {
-                if (fireCapableEnemies[enemy->getPosition().x] == nullptr)
-                    fireCapableEnemies[enemy->getPosition().x] = enemy;
-                else
-                {
-                    if (fireCapableEnemies[enemy->getPosition().x]->getPosition().y < enemy->getPosition().y)
-                        fireCapableEnemies[enemy->getPosition().x] = enemy;
-                }
+                offset.x += movement;
             }
 
+            m_formation.setOffset(offset);
+
             // There has to be at least one enemy left to fire
-            if (!fireCapableEnemies.empty())
+            if (!m_shooterColumns.empty())
             {
-                // Find the enemy that will fire
-                auto it = fireCapableEnemies.begin();
-                std::advance(it, std::uniform_int_distribution<decltype(fireCapableEnemies.size())>{0, fireCapableEnemies.size()-1}(generator));
+                // Only the bottom enemy of every column can fire, pick one of them
+                const auto column = m_shooterColumns[m_fireRandom.nextInt(m_shooterColumns.size())];
+                Model::AttackingEntity* shooter = m_columns[column].enemies.back();
 
                 // Check if one of the enemies should fire
-                m_fireChance += (it->second->getGun().getChanceIncrease() * elapsedSeconds);
-                if (m_fireChance * elapsedSeconds > std::uniform_real_distribution<float>{0.1f, 100.0f}(generator))
+                m_fireChance += (shooter->getGun().getChanceIncrease() * elapsedSeconds);
+                if (m_fireChance * elapsedSeconds > m_fireRandom.nextFloat(0.1f, 100.0f))
                 {
                     m_fireChance = 0;
 
                     // Fire the bullet
-                    if (it->second->getGun().tryToFire())
-                        notifyObservers(Event{Event::Type::GunFired, it->second.get()});
+                    if (shooter->getGun().tryToFire(m_time))
+                        notifyObservers(Event{Event::Type::GunFired, shooter});
                 }
             }
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        bool EnemyController::checkCollision(EntityPtr entity)
+        bool EnemyController::checkCollision(const FloatRect& bounds)
         {
             bool hit = false;
-            for (unsigned int i = 0; i < m_enemies.size();)
-            {
-                if (((m_enemies[i]->getPosition().x >= entity->getPosition().x) && (m_enemies[i]->getPosition().x < entity->getPosition().x + entity->getSize().x))
-                 || ((m_enemies[i]->getPosition().x <= entity->getPosition().x) && (m_enemies[i]->getPosition().x + m_enemies[i]->getSize().x > entity->getPosition().x)))
+
+            // Only the enemies near the bullet have to be checked, the grid contains the positions inside the formation
+            m_grid.query(FloatRect{bounds.left - m_formation.getOffset().x, bounds.top - m_formation.getOffset().y,
+                                   bounds.width, bounds.height}, m_candidates);
+
+            // The store has the positions on the screen, so the enemies themselves aren't needed until one is hit
+            m_candidateBounds.clear();
+            for (const auto id : m_candidates)
+                m_candidateBounds.push(m_store.getBounds(id));
+
+            Collision::forEachOverlap(bounds, m_candidateBounds, [this, &hit](std::size_t i)
                 {
-                    if (((m_enemies[i]->getPosition().y >= entity->getPosition().y) && (m_enemies[i]->getPosition().y < entity->getPosition().y + entity->getSize().y))
-                     || ((m_enemies[i]->getPosition().y <= entity->getPosition().y) && (m_enemies[i]->getPosition().y + m_enemies[i]->getSize().y > entity->getPosition().y)))
+                    Model::Entity* enemy = m_store.getEntities()[m_candidates[i]];
+
+                    // The enemy can't be hit again, but it stays in the list until the end of the tick
+                    m_grid.remove(m_candidates[i]);
+                    m_destroyQueue.push(enemy);
+                    hit = true;
+
+                    // Check if you earned a powerup
+                    if (m_powerupRandom.nextDouble() < POWERUP_CHANCE)
                     {
-                        // Destroy the enemy
-                        m_enemies[i]->destroy();
-                        m_enemies.erase(m_enemies.begin()+i);
-                        hit = true;
-
-                        // Check if you earned a powerup
-                        if (std::uniform_real_distribution<double>{0.0, 1.0}(generator) < POWERUP_CHANCE)
-                        {
-                            // Select a random powerup
-                            auto random = std::uniform_int_distribution<unsigned int>(0, static_cast<unsigned int>(PowerupType::Count)-1)(generator);
-
-                            // Activate the powerup
-                            Event powerupEvent{Event::Type::PowerupActivated, m_enemies[i].get()};
-                            powerupEvent.powerup = static_cast<PowerupType>(random);
-                            notifyObservers(powerupEvent);
-                        }
-
-                        continue;
-                    }
-                }
+                        // Select a random powerup
+                        auto random = m_powerupRandom.nextInt(static_cast<unsigned int>(PowerupType::Count));
 
-                i++;
-            }
+                        // Activate the powerup
+                        Event powerupEvent{Event::Type::PowerupActivated, enemy};
+                        powerupEvent.powerup = static_cast<PowerupType>(random);
+                        notifyObservers(powerupEvent);
+                    }
+                });
 
             return hit;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+        std::size_t EnemyController::removeDestroyed()
+        {
+            return m_destroyQueue.flush(m_enemies, [this](const AttackingEntityPtr& enemy)
+                {
+                    removeFromColumn(enemy.get());
+                    enemy->leaveFormation();
+                    enemy->destroy();
+                });
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
         AttackingEntityList& EnemyController::getEnemies()
         {
             return m_enemies;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const Model::Formation& EnemyController::getFormation() const
+        {
+            return m_formation;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        ModifierStack& EnemyController::getSpeedModifiers()
+        {
+            return m_speedModifiers;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void EnemyController::clear()
+        {
+            m_destroyQueue.clear();
+            m_columns.clear();
+            m_shooterColumns.clear();
+            m_enemyColumns.clear();
+            m_grid.clear();
+            m_enemies.clear();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void EnemyController::createColumns()
+        {
+            // Enemies are in the same column when they have the same horizontal position inside the formation.
+            // This position doesn't change when the formation moves, so the columns only have to be made once.
+            std::vector<std::pair<long, unsigned int>> columnPositions;
+            for (auto& enemy : m_enemies)
+            {
+                const long x = std::lround(enemy->getLocalPosition().x);
+
+                auto it = std::find_if(columnPositions.begin(), columnPositions.end(), [x](const std::pair<long, unsigned int>& column){ return column.first == x; });
+                if (it == columnPositions.end())
+                {
+                    columnPositions.push_back({x, static_cast<unsigned int>(m_columns.size())});
+                    m_columns.push_back(Column{{}, m_shooterColumns.size()});
+                    m_shooterColumns.push_back(columnPositions.back().second);
+                    it = columnPositions.end() - 1;
+                }
+
+                m_columns[it->second].enemies.push_back(enemy.get());
+                m_enemyColumns[enemy.get()] = it->second;
+            }
+
+            // The bottom enemy has to be at the back of the column
+            for (auto& column : m_columns)
+            {
+                std::sort(column.enemies.begin(), column.enemies.end(),
+                          [](Model::AttackingEntity* left, Model::AttackingEntity* right){ return left->getLocalPosition().y < right->getLocalPosition().y; });
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void EnemyController::removeFromColumn(Model::AttackingEntity* enemy)
+        {
+            auto columnIt = m_enemyColumns.find(enemy);
+            if (columnIt == m_enemyColumns.end())
+                return;
+
+            const unsigned int columnIndex = columnIt->second;
+            m_enemyColumns.erase(columnIt);
+
+            Column& column = m_columns[columnIndex];
+            column.enemies.erase(std::find(column.enemies.begin(), column.enemies.end(), enemy));
+
+            // When the column is empty then the last column in the shooter list takes its place
+            if (column.enemies.empty())
+            {
+                const unsigned int movedColumn = m_shooterColumns.back();
+                m_shooterColumns[column.shooterIndex] = movedColumn;
+                m_columns[movedColumn].shooterIndex = column.shooterIndex;
+                m_shooterColumns.pop_back();
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
     }
 }
@@ -22,45 +22,51 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
-#include <SpaceInvaders/View/SFMLEntityRepresentation.hpp>
-#include <SpaceInvaders/Model/Entities.hpp>
+
+#include <SpaceInvaders/Controller/ModifierStack.hpp>
 
 namespace Game
 {
-    namespace View
+    namespace Controller
     {
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        SFMLEntityRepresentation::SFMLEntityRepresentation(sf::RenderTarget& renderTarget, EntityPtr entity) :
-            m_renderTarget(renderTarget)
+        ModifierStack::ModifierId ModifierStack::push(float factor)
         {
-            std::string filename = entity->getImageFilename();
-
-            if (!filename.empty())
-            {
-                if (!m_texture.loadFromFile(filename))
-                    throw std::runtime_error("Failed to create EntityRepresentation (filename was '" + filename + "').");
-
-                m_sprite.setTexture(m_texture);
-                m_sprite.setPosition(entity->getPosition().x, entity->getPosition().y);
-                m_sprite.setScale(entity->getSize().x / m_texture.getSize().x, entity->getSize().y / m_texture.getSize().y);
-            }
+            m_modifiers.push_back(Modifier{m_nextId, factor});
+            m_factor *= factor;
 
-            entity->addObserver(std::bind(&SFMLEntityRepresentation::positionChanged, this, std::placeholders::_1), Event::Type::PositionChanged);
+            return m_nextId++;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        void SFMLEntityRepresentation::draw()
+        bool ModifierStack::remove(ModifierId id)
         {
-            m_renderTarget.draw(m_sprite);
+            for (auto it = m_modifiers.begin(); it != m_modifiers.end(); ++it)
+            {
+                if (it->id == id)
+                {
+                    m_modifiers.erase(it);
+
+                    // Multiplying the remaining ones in the order in which they were added gives the same factor as
+                    // when the removed modifier would never have been added, and exactly 1 once the stack is empty
+                    m_factor = 1;
+                    for (const auto& modifier : m_modifiers)
+                        m_factor *= modifier.factor;
+
+                    return true;
+                }
+            }
+
+            return false;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        void SFMLEntityRepresentation::positionChanged(const Event& event)
+        float ModifierStack::getFactor() const
         {
-            m_sprite.setPosition(event.position.x, event.position.y);
+            return m_factor;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -23,6 +23,8 @@
 
 
 #include <SpaceInvaders/Controller/PlayerController.hpp>
+#include <SpaceInvaders/Collision.hpp>
+#include <SpaceInvaders/Profiler.hpp>
 #include <SpaceInvaders/View/AbstractView.hpp>
 #include <SpaceInvaders/Model/Entities.hpp>
 
@@ -32,29 +34,45 @@ namespace Game
     {
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        PlayerController::PlayerController(AttackingEntityPtr player, View::AbstractView* view) :
-            m_player(player)
+        PlayerController::PlayerController(AttackingEntityPtr player, View::AbstractView* view, Model::EntityStore& store) :
+            m_player(player),
+            m_view  (view)
         {
-            // Add the player to the view
+            // Add the player to the view and the store
             view->addEntity(player);
+            player->attachToStore(store);
 
             // Request a signal when a key is pressed
-            view->addObserver([this](const Event&){ m_moveLeftKeyDown = false; }, Event::Type::MoveLeftKeyReleased);
-            view->addObserver([this](const Event&){ m_moveLeftKeyDown = true; }, Event::Type::MoveLeftKeyPressed);
-            view->addObserver([this](const Event&){ m_moveRightKeyDown = false; }, Event::Type::MoveRightKeyReleased);
-            view->addObserver([this](const Event&){ m_moveRightKeyDown = true; }, Event::Type::MoveRightKeyPressed);
-            view->addObserver([this](const Event&){ m_fireKeyDown = false; }, Event::Type::FireKeyReleased);
-            view->addObserver([this](const Event&){ m_fireKeyDown = true; fireGun(); }, Event::Type::FireKeyPressed);
+            m_viewObservers.push_back(view->addObserver([this](const Event&){ m_moveLeftKeyDown = false; }, Event::Type::MoveLeftKeyReleased));
+            m_viewObservers.push_back(view->addObserver([this](const Event&){ m_moveLeftKeyDown = true; }, Event::Type::MoveLeftKeyPressed));
+            m_viewObservers.push_back(view->addObserver([this](const Event&){ m_moveRightKeyDown = false; }, Event::Type::MoveRightKeyReleased));
+            m_viewObservers.push_back(view->addObserver([this](const Event&){ m_moveRightKeyDown = true; }, Event::Type::MoveRightKeyPressed));
+            m_viewObservers.push_back(view->addObserver([this](const Event&){ m_fireKeyDown = false; }, Event::Type::FireKeyReleased));
+            m_viewObservers.push_back(view->addObserver([this](const Event&){ m_fireKeyDown = true; fireGun(); }, Event::Type::FireKeyPressed));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        PlayerController::~PlayerController()
+        {
+            for (const auto& handle : m_viewObservers)
+                m_view->removeObserver(handle);
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         void PlayerController::update(const sf::Time& elapsedTime)
         {
+            Profiler::ScopedTimer timer{Profiler::Phase::PlayerUpdate};
+
+            m_time += elapsedTime;
+
+            const float distance = m_player->getSpeed() * m_speedModifiers.getFactor() * elapsedTime.asSeconds();
+
             // Move the player to the left if needed
             if (m_moveLeftKeyDown)
             {
-                m_player->setPosition(Vector2f{m_player->getPosition().x - (m_player->getSpeed() * elapsedTime.asSeconds()), m_player->getPosition().y});
+                m_player->setPosition(Vector2f{m_player->getPosition().x - distance, m_player->getPosition().y});
 
                 if (m_player->getPosition().x < 0)
                     m_player->setPosition(Vector2f{0, m_player->getPosition().y});
@@ -63,7 +81,7 @@ namespace Game
             // Move the player to the right if needed
             if (m_moveRightKeyDown)
             {
-                m_player->setPosition(Vector2f{m_player->getPosition().x + (m_player->getSpeed() * elapsedTime.asSeconds()), m_player->getPosition().y});
+                m_player->setPosition(Vector2f{m_player->getPosition().x + distance, m_player->getPosition().y});
 
                 if (m_player->getPosition().x + m_player->getSize().x > SCREEN_WIDTH)
                     m_player->setPosition(Vector2f{SCREEN_WIDTH - m_player->getSize().x, m_player->getPosition().y});
@@ -76,25 +94,18 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        bool PlayerController::checkCollision(EntityPtr entity)
+        bool PlayerController::checkCollision(const FloatRect& bounds)
         {
-            if (((m_player->getPosition().x >= entity->getPosition().x) && (m_player->getPosition().x < entity->getPosition().x + entity->getSize().x))
-             || ((m_player->getPosition().x <= entity->getPosition().x) && (m_player->getPosition().x + m_player->getSize().x > entity->getPosition().x)))
-            {
-                if (((m_player->getPosition().y >= entity->getPosition().y) && (m_player->getPosition().y < entity->getPosition().y + entity->getSize().y))
-                 || ((m_player->getPosition().y <= entity->getPosition().y) && (m_player->getPosition().y + m_player->getSize().y > entity->getPosition().y)))
-                {
-                    Model::PlayerEntity* player = dynamic_cast<Model::PlayerEntity*>(m_player.get());
-                    player->setLives(player->getLives() - 1);
-
-                    Event event{Event::Type::LivesChanged, m_player.get()};
-                    event.lives = player->getLives();
-                    notifyObservers(event);
-                    return true;
-                }
-            }
+            if (!Collision::overlaps(m_player->getBounds(), bounds))
+                return false;
+
+            Model::PlayerEntity* player = dynamic_cast<Model::PlayerEntity*>(m_player.get());
+            player->setLives(player->getLives() - 1);
 
-            return false;
+            Event event{Event::Type::LivesChanged, m_player.get()};
+            event.lives = player->getLives();
+            notifyObservers(event);
+            return true;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -106,10 +117,24 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+        ModifierStack& PlayerController::getSpeedModifiers()
+        {
+            return m_speedModifiers;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        ModifierStack& PlayerController::getFireRateModifiers()
+        {
+            return m_fireRateModifiers;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
         void PlayerController::fireGun()
         {
             // Only fire the gun when the cooldown period is over
-            if (m_player->getGun().tryToFire())
+            if (m_player->getGun().tryToFire(m_time, m_fireRateModifiers.getFactor()))
                 notifyObservers(Event{Event::Type::GunFired, m_player.get()});
         }
 
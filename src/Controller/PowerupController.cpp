@@ -24,6 +24,7 @@
 
 #include <SpaceInvaders/Controller/PowerupController.hpp>
 #include <SpaceInvaders/Controller/Powerups.hpp>
+#include <SpaceInvaders/Profiler.hpp>
 
 namespace Game
 {
@@ -40,6 +41,8 @@ namespace Game
 
         void PowerupController::update(const sf::Time& elapsedTime)
         {
+            Profiler::ScopedTimer timer{Profiler::Phase::PowerupUpdate};
+
             for (unsigned int i = 0; i < m_powerups.size();)
             {
                 if (!m_powerups[i]->update(elapsedTime))
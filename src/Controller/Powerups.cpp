@@ -22,8 +22,8 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <cassert>
 #include <SpaceInvaders/Controller/Powerups.hpp>
-#include <SpaceInvaders/Model/Entities.hpp>
 
 namespace Game
 {
@@ -31,8 +31,7 @@ namespace Game
     {
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        Powerup::Powerup(EntityPtr entity, const sf::Time& duration) :
-            m_entity  (entity),
+        Powerup::Powerup(const sf::Time& duration) :
             m_duration(duration)
         {
         }
@@ -57,36 +56,21 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        SpeedChangePowerup::SpeedChangePowerup(AttackingEntityPtr entity, const sf::Time& duration, float speedFactor) :
-            Powerup      (entity, duration),
-            m_speedFactor(speedFactor)
+        ModifierPowerup::ModifierPowerup(ModifierStack& modifiers, const sf::Time& duration, float factor) :
+            Powerup     (duration),
+            m_modifiers (modifiers),
+            m_modifierId(modifiers.push(factor))
         {
-            entity->setSpeed(entity->getSpeed() * m_speedFactor);
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        SpeedChangePowerup::~SpeedChangePowerup()
+        ModifierPowerup::~ModifierPowerup()
         {
-            auto entity = std::dynamic_pointer_cast<Model::AttackingEntity>(m_entity);
-            entity->setSpeed(entity->getSpeed() / m_speedFactor);
-        }
-
-        ////////////////////////////////////////////////////////////////////////////////////////////////////
-
-        FireRatePowerup::FireRatePowerup(AttackingEntityPtr entity, const sf::Time& duration, float fireRateFactor) :
-            Powerup         (entity, duration),
-            m_fireRateFactor(fireRateFactor)
-        {
-            entity->getGun().setCoolDownTime(entity->getGun().getCoolDownTime() / m_fireRateFactor);
-        }
-
-        ////////////////////////////////////////////////////////////////////////////////////////////////////
-
-        FireRatePowerup::~FireRatePowerup()
-        {
-            auto entity = std::dynamic_pointer_cast<Model::AttackingEntity>(m_entity);
-            entity->getGun().setCoolDownTime(entity->getGun().getCoolDownTime() * m_fireRateFactor);
+            // The destructor can't throw, the modifier was pushed in the constructor so it is always found
+            const bool removed = m_modifiers.remove(m_modifierId);
+            assert(removed);
+            (void)removed;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
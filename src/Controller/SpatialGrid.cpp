@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <algorithm>
+#include <cmath>
+#include <SpaceInvaders/Controller/SpatialGrid.hpp>
+
+namespace Game
+{
+    namespace Controller
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        SpatialGrid::SpatialGrid(float cellSize) :
+            m_cellSize(cellSize),
+            m_columns (static_cast<unsigned int>(std::ceil(SCREEN_WIDTH / cellSize))),
+            m_rows    (static_cast<unsigned int>(std::ceil(SCREEN_HEIGHT / cellSize))),
+            m_cells   (m_columns * m_rows)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SpatialGrid::insert(EntityId id, const FloatRect& bounds)
+        {
+            CellRange range = getCellRange(bounds);
+            m_entityCells[id] = range;
+            addToCells(id, range);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SpatialGrid::remove(EntityId id)
+        {
+            auto it = m_entityCells.find(id);
+            if (it == m_entityCells.end())
+                return;
+
+            removeFromCells(id, it->second);
+            m_entityCells.erase(it);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SpatialGrid::move(EntityId id, const FloatRect& bounds)
+        {
+            auto it = m_entityCells.find(id);
+            if (it == m_entityCells.end())
+                return;
+
+            CellRange range = getCellRange(bounds);
+            if ((range.left == it->second.left) && (range.top == it->second.top) && (range.right == it->second.right) && (range.bottom == it->second.bottom))
+                return;
+
+            removeFromCells(id, it->second);
+            addToCells(id, range);
+            it->second = range;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SpatialGrid::clear()
+        {
+            for (auto& cell : m_cells)
+                cell.clear();
+
+            m_entityCells.clear();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SpatialGrid::query(const FloatRect& area, std::vector<EntityId>& candidates) const
+        {
+            candidates.clear();
+
+            CellRange range = getCellRange(area);
+            for (unsigned int row = range.top; row <= range.bottom; ++row)
+            {
+                for (unsigned int col = range.left; col <= range.right; ++col)
+                {
+                    auto& cell = m_cells[row * m_columns + col];
+                    candidates.insert(candidates.end(), cell.begin(), cell.end());
+                }
+            }
+
+            // An entity can be in more than one of the cells
+            if ((range.left != range.right) || (range.top != range.bottom))
+            {
+                std::sort(candidates.begin(), candidates.end());
+                candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        SpatialGrid::CellRange SpatialGrid::getCellRange(const FloatRect& area) const
+        {
+            auto toCell = [this](float position, unsigned int cellCount)
+            {
+                int cell = static_cast<int>(std::floor(position / m_cellSize));
+                return static_cast<unsigned int>(std::min(std::max(cell, 0), static_cast<int>(cellCount) - 1));
+            };
+
+            return CellRange{toCell(area.left, m_columns), toCell(area.top, m_rows),
+                             toCell(area.left + area.width, m_columns), toCell(area.top + area.height, m_rows)};
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SpatialGrid::addToCells(EntityId id, const CellRange& range)
+        {
+            for (unsigned int row = range.top; row <= range.bottom; ++row)
+            {
+                for (unsigned int col = range.left; col <= range.right; ++col)
+                    m_cells[row * m_columns + col].push_back(id);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SpatialGrid::removeFromCells(EntityId id, const CellRange& range)
+        {
+            for (unsigned int row = range.top; row <= range.bottom; ++row)
+            {
+                for (unsigned int col = range.left; col <= range.right; ++col)
+                {
+                    auto& cell = m_cells[row * m_columns + col];
+                    auto it = std::find(cell.begin(), cell.end(), id);
+                    if (it != cell.end())
+                    {
+                        *it = cell.back();
+                        cell.pop_back();
+                    }
+                }
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -32,46 +32,92 @@ namespace Game
     {
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        WallController::WallController(EntityList walls, View::AbstractView* view) :
-            m_walls(walls)
+        WallController::WallController(EntityList walls, BunkerList bunkers, View::AbstractView* view, Model::EntityStore& store) :
+            m_walls  (walls),
+            m_store  (store),
+            m_bunkers(bunkers)
         {
             for (auto& wall : m_walls)
+            {
                 view->addEntity(wall);
+                wall->attachToStore(store);
+                m_grid.insert(wall->getStoreId(), wall->getBounds());
+            }
+
+            for (auto& bunker : m_bunkers)
+            {
+                view->addEntity(bunker);
+                bunker->attachToStore(store);
+                m_bunkerBounds.push(bunker->getBounds());
+            }
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        bool WallController::checkCollision(EntityPtr entity)
+        bool WallController::checkCollision(const FloatRect& bounds)
         {
             bool hit = false;
-            for (unsigned int i = 0; i < m_walls.size();)
+
+            // Only the walls near the bullet have to be checked, their bounds are read from the store
+            if (!m_walls.empty())
             {
-                if (((m_walls[i]->getPosition().x >= entity->getPosition().x) && (m_walls[i]->getPosition().x < entity->getPosition().x + entity->getSize().x))
-                 || ((m_walls[i]->getPosition().x <= entity->getPosition().x) && (m_walls[i]->getPosition().x + m_walls[i]->getSize().x > entity->getPosition().x)))
-                {
-                    if (((m_walls[i]->getPosition().y >= entity->getPosition().y) && (m_walls[i]->getPosition().y < entity->getPosition().y + entity->getSize().y))
-                     || ((m_walls[i]->getPosition().y <= entity->getPosition().y) && (m_walls[i]->getPosition().y + m_walls[i]->getSize().y > entity->getPosition().y)))
+                m_grid.query(bounds, m_candidates);
+
+                m_candidateBounds.clear();
+                for (const auto id : m_candidates)
+                    m_candidateBounds.push(m_store.getBounds(id));
+
+                Collision::forEachOverlap(bounds, m_candidateBounds, [this, &hit](std::size_t i)
                     {
-                        m_walls[i]->destroy();
-                        m_walls.erase(m_walls.begin()+i);
+                        // The wall can't be hit again, but it stays in the list until the end of the tick
+                        m_grid.remove(m_candidates[i]);
+                        m_destroyQueue.push(m_store.getEntities()[m_candidates[i]]);
                         hit = true;
-                        continue;
-                    }
-                }
-
-                i++;
+                    });
             }
 
+            // The cells are only looked at for the bunkers that the entity overlaps with
+            Collision::forEachOverlap(bounds, m_bunkerBounds, [this, &bounds, &hit](std::size_t i)
+                {
+                    if (m_bunkers[i]->erode(bounds))
+                        hit = true;
+                });
+
             return hit;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+        std::size_t WallController::removeDestroyed()
+        {
+            return m_destroyQueue.flush(m_walls, [](const EntityPtr& wall){ wall->destroy(); });
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
         EntityList& WallController::getWalls()
         {
             return m_walls;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        BunkerList& WallController::getBunkers()
+        {
+            return m_bunkers;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void WallController::clear()
+        {
+            m_destroyQueue.clear();
+            m_grid.clear();
+            m_walls.clear();
+            m_bunkers.clear();
+            m_bunkerBounds.clear();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
     }
 }
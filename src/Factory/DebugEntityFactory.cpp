@@ -58,27 +58,29 @@ namespace Game
 
     EntityList DebugEntityFactory::createWalls(unsigned int)
     {
-        auto walls = EntityList();
+        return EntityList();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    BunkerList DebugEntityFactory::createBunkers(unsigned int)
+    {
+        auto bunkers = BunkerList();
+
+        // Every bunker is an arch with an opening at the bottom of half its width and two fifth of its height
+        const Vector2f bunkerSize{1.0f/7.0f * SCREEN_WIDTH, 1.0f/18.0f * SCREEN_HEIGHT * 5 / 3};
+        const unsigned int columns = 32;
+        const unsigned int rows = 20;
 
-        // Create the wall blocks with the correct position
         for (unsigned int block = 0; block < 3; ++block)
         {
-            Vector2f blockPosition{(1.0f/7.0f * SCREEN_WIDTH) + ((2.0f/7.0f * SCREEN_WIDTH) * block),
-                                   (9.0f/12.0f) * SCREEN_HEIGHT};
-
-            for (unsigned int col = 0; col < 4; ++col)
-            {
-                unsigned int rows = (col == 0 || col == 3) ? 5 : 3;
-                for (unsigned int row = 0; row < rows; ++row)
-                {
-                    walls.insert(walls.end(), std::shared_ptr<Model::Entity>{new Model::WallEntity("Resources/Wall.png")});
-                    walls.back()->setSize(Vector2f{1.0f/7.0f * SCREEN_WIDTH / 4, 1.0f/18.0f * SCREEN_HEIGHT / 3});
-                    walls.back()->setPosition(Vector2f{blockPosition.x + (walls.back()->getSize().x * col), blockPosition.y + (walls.back()->getSize().y * row)});
-                }
-            }
+            bunkers.push_back(BunkerPtr{new Model::BunkerEntity{"Resources/Wall.png", columns, rows, Vector2f{bunkerSize.x / columns, bunkerSize.y / rows}}});
+            bunkers.back()->removeCells(columns / 4, rows - (rows * 2 / 5), columns / 2, rows * 2 / 5);
+            bunkers.back()->setPosition(Vector2f{(1.0f/7.0f * SCREEN_WIDTH) + ((2.0f/7.0f * SCREEN_WIDTH) * block),
+                                                 (9.0f/12.0f) * SCREEN_HEIGHT});
         }
 
-        return walls;
+        return bunkers;
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////
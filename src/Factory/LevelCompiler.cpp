@@ -0,0 +1,392 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <SpaceInvaders/Factory/LevelCompiler.hpp>
+#include <SpaceInvaders/Factory/LevelFormat.hpp>
+#include <SpaceInvaders/Model/Entities.hpp>
+
+namespace Game
+{
+    namespace
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // Everything that was read from the text, in the form in which it will be written
+        struct Levels
+        {
+            std::string strings;
+            std::map<std::string, std::uint32_t> stringOffsets;
+            std::map<std::string, std::uint32_t> gunIndices;
+
+            std::vector<LevelFormat::Gun>   guns;
+            std::vector<LevelFormat::Player> players;
+            std::vector<LevelFormat::Level> levels;
+            std::vector<LevelFormat::Enemy> enemies;
+            std::vector<LevelFormat::Wall>  walls;
+            std::vector<LevelFormat::Bunker> bunkers;
+
+            bool insideLevel = false;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // Reads the values of a single line and reports errors with the line number
+        class LineReader
+        {
+        public:
+            LineReader(const std::string& line, unsigned int lineNumber) :
+                m_stream    (line),
+                m_lineNumber(lineNumber)
+            {
+            }
+
+            void error(const std::string& message) const
+            {
+                throw std::runtime_error("Line " + std::to_string(m_lineNumber) + ": " + message);
+            }
+
+            bool tryReadString(std::string& value)
+            {
+                return static_cast<bool>(m_stream >> value);
+            }
+
+            std::string readString(const char* name)
+            {
+                std::string value;
+                if (!(m_stream >> value))
+                    error(std::string("Missing ") + name + ".");
+
+                return value;
+            }
+
+            float readFloat(const char* name)
+            {
+                float value;
+                if (!(m_stream >> value))
+                    error(std::string("Missing or invalid ") + name + ".");
+
+                return value;
+            }
+
+            std::uint32_t readUnsigned(const char* name)
+            {
+                long long value;
+                if (!(m_stream >> value) || (value < 0) || (value > UINT32_MAX))
+                    error(std::string("Missing or invalid ") + name + ".");
+
+                return static_cast<std::uint32_t>(value);
+            }
+
+            void finish()
+            {
+                std::string value;
+                if (m_stream >> value)
+                    error("Unexpected value '" + value + "'.");
+            }
+
+        private:
+            std::istringstream m_stream;
+            unsigned int m_lineNumber;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::uint32_t addString(Levels& levels, const std::string& value)
+        {
+            auto it = levels.stringOffsets.find(value);
+            if (it != levels.stringOffsets.end())
+                return it->second;
+
+            const auto offset = static_cast<std::uint32_t>(levels.strings.size());
+            levels.strings += value;
+            levels.strings += '\0';
+
+            levels.stringOffsets[value] = offset;
+            return offset;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::uint32_t findGun(const Levels& levels, LineReader& reader)
+        {
+            const std::string name = reader.readString("gun");
+
+            auto it = levels.gunIndices.find(name);
+            if (it == levels.gunIndices.end())
+                reader.error("Unknown gun '" + name + "', guns have to be defined before they are used.");
+
+            return it->second;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void parseLine(Levels& levels, const std::string& keyword, LineReader& reader)
+        {
+            if (keyword == "gun")
+            {
+                const std::string name = reader.readString("name");
+                if (levels.gunIndices.count(name))
+                    reader.error("The gun '" + name + "' was already defined.");
+
+                LevelFormat::Gun gun;
+                gun.name = addString(levels, name);
+                gun.bulletImage = addString(levels, reader.readString("bullet image"));
+                gun.bulletWidth = reader.readFloat("bullet width");
+                gun.bulletHeight = reader.readFloat("bullet height");
+                gun.speed = reader.readFloat("speed");
+                gun.speedPerLevel = reader.readFloat("speed per level");
+                gun.coolDown = reader.readFloat("cooldown");
+                gun.coolDownPerLevel = reader.readFloat("cooldown per level");
+                gun.fireChance = reader.readFloat("fire chance");
+                gun.fireChancePerLevel = reader.readFloat("fire chance per level");
+
+                levels.gunIndices[name] = static_cast<std::uint32_t>(levels.guns.size());
+                levels.guns.push_back(gun);
+            }
+            else if (keyword == "player")
+            {
+                if (!levels.players.empty())
+                    reader.error("The player was already defined.");
+
+                LevelFormat::Player player;
+                player.image = addString(levels, reader.readString("image"));
+                player.gun = findGun(levels, reader);
+                player.x = reader.readFloat("x");
+                player.y = reader.readFloat("y");
+                player.width = reader.readFloat("width");
+                player.height = reader.readFloat("height");
+                player.speed = reader.readFloat("speed");
+                player.speedPerLevel = reader.readFloat("speed per level");
+                player.lives = reader.readUnsigned("lives");
+
+                levels.players.push_back(player);
+            }
+            else if (keyword == "level")
+            {
+                if (levels.insideLevel)
+                    reader.error("The previous level wasn't ended yet.");
+
+                levels.insideLevel = true;
+                levels.levels.push_back(LevelFormat::Level{static_cast<std::uint32_t>(levels.enemies.size()), 0,
+                                                           static_cast<std::uint32_t>(levels.walls.size()), 0,
+                                                           static_cast<std::uint32_t>(levels.bunkers.size()), 0});
+            }
+            else if (keyword == "end")
+            {
+                if (!levels.insideLevel)
+                    reader.error("There is no level to end.");
+                if (levels.levels.back().enemyCount == 0)
+                    reader.error("The level doesn't contain any enemies.");
+
+                levels.insideLevel = false;
+            }
+            else if (keyword == "enemies")
+            {
+                if (!levels.insideLevel)
+                    reader.error("Enemies can only be placed inside a level.");
+
+                LevelFormat::Enemy enemy;
+                enemy.image = addString(levels, reader.readString("image"));
+                enemy.gun = findGun(levels, reader);
+                const float x = reader.readFloat("x");
+                const float y = reader.readFloat("y");
+                const std::uint32_t columns = reader.readUnsigned("columns");
+                const std::uint32_t rows = reader.readUnsigned("rows");
+                const float spacingX = reader.readFloat("spacing x");
+                const float spacingY = reader.readFloat("spacing y");
+                enemy.width = reader.readFloat("width");
+                enemy.height = reader.readFloat("height");
+                enemy.speed = reader.readFloat("speed");
+                enemy.speedPerLevel = reader.readFloat("speed per level");
+                enemy.points = reader.readUnsigned("points");
+                enemy.pointsPerLevel = reader.readUnsigned("points per level");
+
+                for (std::uint32_t row = 0; row < rows; ++row)
+                {
+                    for (std::uint32_t column = 0; column < columns; ++column)
+                    {
+                        enemy.x = x + (spacingX * column);
+                        enemy.y = y + (spacingY * row);
+                        levels.enemies.push_back(enemy);
+                    }
+                }
+
+                levels.levels.back().enemyCount += columns * rows;
+            }
+            else if (keyword == "walls")
+            {
+                if (!levels.insideLevel)
+                    reader.error("Walls can only be placed inside a level.");
+
+                LevelFormat::Wall wall;
+                wall.image = addString(levels, reader.readString("image"));
+                const float x = reader.readFloat("x");
+                const float y = reader.readFloat("y");
+                const std::uint32_t columns = reader.readUnsigned("columns");
+                const std::uint32_t rows = reader.readUnsigned("rows");
+                wall.width = reader.readFloat("width");
+                wall.height = reader.readFloat("height");
+
+                // The walls are placed against each other
+                for (std::uint32_t row = 0; row < rows; ++row)
+                {
+                    for (std::uint32_t column = 0; column < columns; ++column)
+                    {
+                        wall.x = x + (wall.width * column);
+                        wall.y = y + (wall.height * row);
+                        levels.walls.push_back(wall);
+                    }
+                }
+
+                levels.levels.back().wallCount += columns * rows;
+            }
+            else if (keyword == "bunker")
+            {
+                if (!levels.insideLevel)
+                    reader.error("Bunkers can only be placed inside a level.");
+
+                LevelFormat::Bunker bunker;
+                bunker.image = addString(levels, reader.readString("image"));
+                bunker.x = reader.readFloat("x");
+                bunker.y = reader.readFloat("y");
+                bunker.width = reader.readFloat("width");
+                bunker.height = reader.readFloat("height");
+                bunker.columns = reader.readUnsigned("columns");
+                bunker.rows = reader.readUnsigned("rows");
+                bunker.gapColumns = reader.readUnsigned("gap columns");
+                bunker.gapRows = reader.readUnsigned("gap rows");
+
+                if ((bunker.columns == 0) || (bunker.columns > Model::BunkerEntity::MAX_COLUMNS) || (bunker.rows == 0))
+                    reader.error("A bunker needs between 1 and 64 columns and at least one row.");
+                if ((bunker.gapColumns > bunker.columns) || (bunker.gapRows > bunker.rows))
+                    reader.error("The opening is larger than the bunker.");
+
+                levels.bunkers.push_back(bunker);
+                levels.levels.back().bunkerCount++;
+            }
+            else
+                reader.error("Unknown keyword '" + keyword + "'.");
+
+            reader.finish();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // Append a table to the file and fill in where it can be found
+        template <typename T>
+        void writeTable(std::vector<char>& file, LevelFormat::Table& table, const std::vector<T>& elements)
+        {
+            table.offset = static_cast<std::uint32_t>(file.size());
+            table.count = static_cast<std::uint32_t>(elements.size());
+
+            const char* data = reinterpret_cast<const char*>(elements.data());
+            file.insert(file.end(), data, data + (elements.size() * sizeof(T)));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::vector<char> LevelCompiler::compile(std::istream& source)
+    {
+        Levels levels;
+
+        std::string line;
+        unsigned int lineNumber = 0;
+        while (std::getline(source, line))
+        {
+            lineNumber++;
+
+            // Skip empty lines and comments
+            LineReader reader{line, lineNumber};
+            std::string keyword;
+            if (!reader.tryReadString(keyword) || (keyword[0] == '#'))
+                continue;
+
+            parseLine(levels, keyword, reader);
+        }
+
+        if (levels.insideLevel)
+            throw std::runtime_error("The last level wasn't ended.");
+        if (levels.players.empty())
+            throw std::runtime_error("The player wasn't defined.");
+        if (levels.levels.empty())
+            throw std::runtime_error("There are no levels.");
+
+        // Keep the tables after the string table aligned
+        levels.strings.resize((levels.strings.size() + 3) / 4 * 4, '\0');
+
+        LevelFormat::Header header;
+        std::memcpy(header.magic, LevelFormat::MAGIC, sizeof(header.magic));
+        header.version = LevelFormat::VERSION;
+
+        std::vector<char> file(sizeof(header));
+        writeTable(file, header.strings, std::vector<char>{levels.strings.begin(), levels.strings.end()});
+        writeTable(file, header.guns, levels.guns);
+
+        LevelFormat::Table playerTable;
+        writeTable(file, playerTable, levels.players);
+        header.player = playerTable.offset;
+
+        writeTable(file, header.levels, levels.levels);
+        writeTable(file, header.enemies, levels.enemies);
+        writeTable(file, header.walls, levels.walls);
+        writeTable(file, header.bunkers, levels.bunkers);
+
+        std::memcpy(file.data(), &header, sizeof(header));
+        return file;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void LevelCompiler::compileFile(const std::string& sourceFilename, const std::string& outputFilename)
+    {
+        std::ifstream source{sourceFilename};
+        if (!source)
+            throw std::runtime_error("Failed to open '" + sourceFilename + "'.");
+
+        std::vector<char> file;
+        try
+        {
+            file = compile(source);
+        }
+        catch (const std::runtime_error& e)
+        {
+            throw std::runtime_error(sourceFilename + ": " + e.what());
+        }
+
+        std::ofstream output{outputFilename, std::ios::binary};
+        if (!output.write(file.data(), file.size()))
+            throw std::runtime_error("Failed to write '" + outputFilename + "'.");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
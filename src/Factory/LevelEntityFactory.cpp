@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <SpaceInvaders/Factory/LevelEntityFactory.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+    #include <fstream>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Game
+{
+    namespace
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // Names of the guns in the level file that are used for each GunType
+        const char* getGunName(GunType type)
+        {
+            switch (type)
+            {
+                case GunType::Normal: return "Normal";
+                case GunType::Enemy1: return "Enemy1";
+                case GunType::Enemy2: return "Enemy2";
+                case GunType::Enemy3: return "Enemy3";
+
+                default:
+                    throw std::logic_error("Firing an unknown gun type.");
+            };
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // Load the whole file in memory, the returned pointer releases the memory when it is destroyed
+        std::shared_ptr<const char> mapFile(const std::string& filename, std::size_t& size)
+        {
+#ifdef _WIN32
+            // There is no mmap on windows, so just read the file
+            std::ifstream file{filename, std::ios::binary | std::ios::ate};
+            if (!file)
+                throw std::runtime_error("Failed to open '" + filename + "'.");
+
+            size = static_cast<std::size_t>(file.tellg());
+            std::shared_ptr<char> data{new char[size + 1], std::default_delete<char[]>()};
+
+            file.seekg(0);
+            if (!file.read(data.get(), size))
+                throw std::runtime_error("Failed to read '" + filename + "'.");
+
+            return data;
+#else
+            const int file = open(filename.c_str(), O_RDONLY);
+            if (file < 0)
+                throw std::runtime_error("Failed to open '" + filename + "'.");
+
+            struct stat status;
+            if ((fstat(file, &status) < 0) || (status.st_size == 0))
+            {
+                close(file);
+                throw std::runtime_error("Failed to read '" + filename + "'.");
+            }
+
+            size = static_cast<std::size_t>(status.st_size);
+            void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+            // The mapping stays valid after the file is closed
+            close(file);
+            if (data == MAP_FAILED)
+                throw std::runtime_error("Failed to map '" + filename + "' into memory.");
+
+            return std::shared_ptr<const char>{static_cast<const char*>(data),
+                                               [size](const char* mapped){ munmap(const_cast<char*>(mapped), size); }};
+#endif
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // Check that a table lies completely inside the file and is aligned
+        void checkTable(const LevelFormat::Table& table, std::size_t elementSize, std::size_t fileSize, const char* name)
+        {
+            if ((table.offset % 4 != 0)
+             || (static_cast<std::uint64_t>(table.offset) + (static_cast<std::uint64_t>(table.count) * elementSize) > fileSize))
+            {
+                throw std::runtime_error(std::string("The ") + name + " table lies outside the level file.");
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    LevelEntityFactory::LevelEntityFactory(const std::string& filename)
+    {
+        std::size_t size;
+        m_file = mapFile(filename, size);
+        m_header = getTable<LevelFormat::Header>(0);
+
+        try
+        {
+            if ((size < sizeof(LevelFormat::Header)) || (std::memcmp(m_header->magic, LevelFormat::MAGIC, sizeof(LevelFormat::MAGIC)) != 0))
+                throw std::runtime_error("It isn't a level file.");
+            if (m_header->version != LevelFormat::VERSION)
+                throw std::runtime_error("Version " + std::to_string(m_header->version) + " is not supported, recompile the level file.");
+
+            checkTable(m_header->strings, 1, size, "string");
+            checkTable(m_header->guns, sizeof(LevelFormat::Gun), size, "gun");
+            checkTable(LevelFormat::Table{m_header->player, 1}, sizeof(LevelFormat::Player), size, "player");
+            checkTable(m_header->levels, sizeof(LevelFormat::Level), size, "level");
+            checkTable(m_header->enemies, sizeof(LevelFormat::Enemy), size, "enemy");
+            checkTable(m_header->walls, sizeof(LevelFormat::Wall), size, "wall");
+            checkTable(m_header->bunkers, sizeof(LevelFormat::Bunker), size, "bunker");
+
+            // When the table ends with a null character, every string in it is null-terminated
+            if ((m_header->strings.count == 0) || (m_file.get()[m_header->strings.offset + m_header->strings.count - 1] != '\0'))
+                throw std::runtime_error("The string table is not terminated.");
+
+            const auto checkString = [this](std::uint32_t offset) {
+                if (offset >= m_header->strings.count)
+                    throw std::runtime_error("A string lies outside the string table.");
+            };
+            const auto checkGun = [this](std::uint32_t gun) {
+                if (gun >= m_header->guns.count)
+                    throw std::runtime_error("A gun lies outside the gun table.");
+            };
+
+            const auto guns = getTable<LevelFormat::Gun>(m_header->guns.offset);
+            for (std::uint32_t i = 0; i < m_header->guns.count; ++i)
+            {
+                checkString(guns[i].name);
+                checkString(guns[i].bulletImage);
+            }
+
+            const auto& player = *getTable<LevelFormat::Player>(m_header->player);
+            checkString(player.image);
+            checkGun(player.gun);
+
+            const auto levels = getTable<LevelFormat::Level>(m_header->levels.offset);
+            if (m_header->levels.count == 0)
+                throw std::runtime_error("There are no levels.");
+            for (std::uint32_t i = 0; i < m_header->levels.count; ++i)
+            {
+                if ((levels[i].enemyCount == 0)
+                 || (static_cast<std::uint64_t>(levels[i].firstEnemy) + levels[i].enemyCount > m_header->enemies.count)
+                 || (static_cast<std::uint64_t>(levels[i].firstWall) + levels[i].wallCount > m_header->walls.count)
+                 || (static_cast<std::uint64_t>(levels[i].firstBunker) + levels[i].bunkerCount > m_header->bunkers.count))
+                {
+                    throw std::runtime_error("Level " + std::to_string(i + 1) + " is invalid.");
+                }
+            }
+
+            const auto enemies = getTable<LevelFormat::Enemy>(m_header->enemies.offset);
+            for (std::uint32_t i = 0; i < m_header->enemies.count; ++i)
+            {
+                checkString(enemies[i].image);
+                checkGun(enemies[i].gun);
+            }
+
+            const auto walls = getTable<LevelFormat::Wall>(m_header->walls.offset);
+            for (std::uint32_t i = 0; i < m_header->walls.count; ++i)
+                checkString(walls[i].image);
+
+            const auto bunkers = getTable<LevelFormat::Bunker>(m_header->bunkers.offset);
+            for (std::uint32_t i = 0; i < m_header->bunkers.count; ++i)
+            {
+                checkString(bunkers[i].image);
+
+                if ((bunkers[i].columns == 0) || (bunkers[i].columns > Model::BunkerEntity::MAX_COLUMNS) || (bunkers[i].rows == 0)
+                 || (bunkers[i].gapColumns > bunkers[i].columns) || (bunkers[i].gapRows > bunkers[i].rows))
+                {
+                    throw std::runtime_error("Bunker " + std::to_string(i + 1) + " is invalid.");
+                }
+            }
+        }
+        catch (const std::runtime_error& e)
+        {
+            throw std::runtime_error("Failed to load '" + filename + "': " + e.what());
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    unsigned int LevelEntityFactory::getLevelCount() const
+    {
+        return m_header->levels.count;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    AttackingEntityList LevelEntityFactory::createEnemies(unsigned int difficulty)
+    {
+        const LevelFormat::Level& level = getLevel(difficulty);
+        const auto enemies = getTable<LevelFormat::Enemy>(m_header->enemies.offset) + level.firstEnemy;
+
+        auto entities = AttackingEntityList();
+        entities.reserve(level.enemyCount);
+
+        for (std::uint32_t i = 0; i < level.enemyCount; ++i)
+        {
+            const LevelFormat::Enemy& enemy = enemies[i];
+            entities.insert(entities.end(), AttackingEntityPtr{new Model::EnemyEntity{getString(enemy.image),
+                                                                                      createGunFromTable(difficulty, enemy.gun),
+                                                                                      enemy.points + (enemy.pointsPerLevel * difficulty)}});
+
+            entities.back()->setSize(Vector2f{enemy.width, enemy.height});
+            entities.back()->setSpeed(enemy.speed + (enemy.speedPerLevel * difficulty));
+            entities.back()->setPosition(Vector2f{enemy.x, enemy.y});
+        }
+
+        return entities;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    EntityList LevelEntityFactory::createWalls(unsigned int difficulty)
+    {
+        const LevelFormat::Level& level = getLevel(difficulty);
+        const auto walls = getTable<LevelFormat::Wall>(m_header->walls.offset) + level.firstWall;
+
+        auto entities = EntityList();
+        entities.reserve(level.wallCount);
+
+        for (std::uint32_t i = 0; i < level.wallCount; ++i)
+        {
+            entities.insert(entities.end(), std::shared_ptr<Model::Entity>{new Model::WallEntity(getString(walls[i].image))});
+            entities.back()->setSize(Vector2f{walls[i].width, walls[i].height});
+            entities.back()->setPosition(Vector2f{walls[i].x, walls[i].y});
+        }
+
+        return entities;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    BunkerList LevelEntityFactory::createBunkers(unsigned int difficulty)
+    {
+        const LevelFormat::Level& level = getLevel(difficulty);
+        const auto bunkers = getTable<LevelFormat::Bunker>(m_header->bunkers.offset) + level.firstBunker;
+
+        auto entities = BunkerList();
+        entities.reserve(level.bunkerCount);
+
+        for (std::uint32_t i = 0; i < level.bunkerCount; ++i)
+        {
+            const LevelFormat::Bunker& bunker = bunkers[i];
+            const Vector2f cellSize{bunker.width / bunker.columns, bunker.height / bunker.rows};
+
+            entities.push_back(BunkerPtr{new Model::BunkerEntity{getString(bunker.image), bunker.columns, bunker.rows, cellSize}});
+            entities.back()->removeCells((bunker.columns - bunker.gapColumns) / 2, bunker.rows - bunker.gapRows, bunker.gapColumns, bunker.gapRows);
+            entities.back()->setPosition(Vector2f{bunker.x, bunker.y});
+        }
+
+        return entities;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    AttackingEntityPtr LevelEntityFactory::createPlayer(unsigned int difficulty)
+    {
+        const auto& record = *getTable<LevelFormat::Player>(m_header->player);
+
+        auto player = std::shared_ptr<Model::PlayerEntity>(new Model::PlayerEntity{getString(record.image), createGunFromTable(difficulty, record.gun)});
+        player->setSpeed(record.speed + (record.speedPerLevel * difficulty));
+        player->setLives(record.lives);
+
+        player->setSize(Vector2f{record.width, record.height});
+        player->setPosition(Vector2f{record.x, record.y});
+
+        return player;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Model::Gun LevelEntityFactory::createGun(unsigned int difficulty, GunType type)
+    {
+        const char* name = getGunName(type);
+
+        const auto guns = getTable<LevelFormat::Gun>(m_header->guns.offset);
+        for (std::uint32_t i = 0; i < m_header->guns.count; ++i)
+        {
+            if (std::strcmp(getString(guns[i].name), name) == 0)
+                return createGunFromTable(difficulty, i);
+        }
+
+        throw std::runtime_error(std::string("The level file doesn't contain the gun '") + name + "'.");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const char* LevelEntityFactory::getString(std::uint32_t offset) const
+    {
+        return m_file.get() + m_header->strings.offset + offset;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const LevelFormat::Level& LevelEntityFactory::getLevel(unsigned int difficulty) const
+    {
+        const unsigned int level = std::min(std::max(difficulty, 1u), getLevelCount()) - 1;
+        return getTable<LevelFormat::Level>(m_header->levels.offset)[level];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Model::Gun LevelEntityFactory::createGunFromTable(unsigned int difficulty, std::uint32_t gun) const
+    {
+        const LevelFormat::Gun& record = getTable<LevelFormat::Gun>(m_header->guns.offset)[gun];
+        const float coolDown = record.coolDown + (record.coolDownPerLevel * difficulty);
+
+        return Model::Gun{ getString(record.bulletImage),
+                           Vector2f{record.bulletWidth, record.bulletHeight},
+                           record.speed + (record.speedPerLevel * difficulty),
+                           sf::microseconds(static_cast<sf::Int64>(coolDown * 1000)),
+                           record.fireChance + (record.fireChancePerLevel * difficulty)
+                         };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
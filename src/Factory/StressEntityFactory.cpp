@@ -0,0 +1,209 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <SpaceInvaders/Factory/StressEntityFactory.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Game
+{
+    namespace
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // A grid of cells that are as square as possible and together fill an area
+        struct Grid
+        {
+            Grid(unsigned int count, const FloatRect& area) :
+                columns(std::max(1u, static_cast<unsigned int>(std::ceil(std::sqrt(count * area.width / area.height))))),
+                rows   ((count + columns - 1) / columns),
+                cell   {area.width / columns, area.height / std::max(1u, rows)}
+            {
+            }
+
+            unsigned int columns;
+            unsigned int rows;
+            Vector2f     cell;
+        };
+
+        // The parts of the screen that are filled
+        const FloatRect ENEMY_AREA  = {100, 30, 600, 300};
+        const FloatRect WALL_AREA   = {0, 400, SCREEN_WIDTH, 80};
+        const FloatRect BULLET_AREA = {0, 0, SCREEN_WIDTH, 390};
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    StressEntityFactory::StressEntityFactory(unsigned int enemies, unsigned int walls, unsigned int bullets) :
+        m_enemies(enemies),
+        m_walls  (walls),
+        m_bullets(bullets)
+    {
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    EntityFactoryCreator StressEntityFactory::parseArguments(std::vector<std::string>& arguments, std::vector<std::string>* option)
+    {
+        auto it = std::find(arguments.begin(), arguments.end(), "--stress");
+        if (it == arguments.end())
+            return nullptr;
+
+        if (arguments.end() - it < 4)
+            throw std::runtime_error("The --stress option needs the amount of enemies, walls and bullets.");
+
+        unsigned int counts[3];
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            const std::string& value = *(it + 1 + i);
+            if (value.empty() || (value.find_first_not_of("0123456789") != std::string::npos))
+                throw std::runtime_error("Invalid amount '" + value + "' given to the --stress option.");
+
+            counts[i] = std::stoul(value);
+        }
+
+        if (option)
+            option->assign(it, it + 4);
+
+        arguments.erase(it, it + 4);
+        return makeFactoryCreator(StressEntityFactory{counts[0], counts[1], counts[2]});
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    AttackingEntityList StressEntityFactory::createEnemies(unsigned int difficulty)
+    {
+        auto enemies = AttackingEntityList();
+        enemies.reserve(m_enemies);
+
+        // Leave some space between the enemies, like in the normal levels
+        const Grid grid{m_enemies, ENEMY_AREA};
+        for (unsigned int i = 0; i < m_enemies; ++i)
+        {
+            const unsigned int row = i / grid.columns;
+            const unsigned int col = i % grid.columns;
+
+            if (row % 3 == 0)
+                enemies.insert(enemies.end(), AttackingEntityPtr{new Model::EnemyEntity{"Resources/Enemy3.png", createGun(difficulty, GunType::Enemy3), difficulty * 20}});
+            else if (row % 3 == 1)
+                enemies.insert(enemies.end(), AttackingEntityPtr{new Model::EnemyEntity{"Resources/Enemy2.png", createGun(difficulty, GunType::Enemy2), difficulty * 10}});
+            else
+                enemies.insert(enemies.end(), AttackingEntityPtr{new Model::EnemyEntity{"Resources/Enemy1.png", createGun(difficulty, GunType::Enemy1), difficulty * 5}});
+
+            enemies.back()->setSize(Vector2f{grid.cell.x * 0.8f, grid.cell.y * 0.8f});
+            enemies.back()->setSpeed(20 + (4 * difficulty));
+            enemies.back()->setPosition(Vector2f{ENEMY_AREA.left + (grid.cell.x * col), ENEMY_AREA.top + (grid.cell.y * row)});
+        }
+
+        return enemies;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    EntityList StressEntityFactory::createWalls(unsigned int)
+    {
+        auto walls = EntityList();
+        walls.reserve(m_walls);
+
+        // The wall blocks are placed against each other
+        const Grid grid{m_walls, WALL_AREA};
+        for (unsigned int i = 0; i < m_walls; ++i)
+        {
+            walls.insert(walls.end(), std::shared_ptr<Model::Entity>{new Model::WallEntity("Resources/Wall.png")});
+            walls.back()->setSize(grid.cell);
+            walls.back()->setPosition(Vector2f{WALL_AREA.left + (grid.cell.x * (i % grid.columns)),
+                                               WALL_AREA.top + (grid.cell.y * (i / grid.columns))});
+        }
+
+        return walls;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    AttackingEntityPtr StressEntityFactory::createPlayer(unsigned int difficulty)
+    {
+        auto player = std::shared_ptr<Model::PlayerEntity>(new Model::PlayerEntity{"Resources/Player.png", createGun(difficulty, GunType::Normal)});
+        player->setSpeed(260 - (5 * difficulty));
+        player->setLives(3);
+
+        player->setSize(Vector2f{2.0f / 20.0f * SCREEN_WIDTH, 5.0f / 80.0f * SCREEN_HEIGHT});
+        player->setPosition(Vector2f{(SCREEN_WIDTH - player->getSize().x) / 2.0f, SCREEN_HEIGHT - (player->getSize().y * (3.0f / 2.0f))});
+
+        return player;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Model::Gun StressEntityFactory::createGun(unsigned int difficulty, GunType type)
+    {
+        switch (type)
+        {
+            case GunType::Normal:
+                return Model::Gun{ "Resources/Bullet.png", // bullet filename
+                                   Vector2f{1.0f / 120.0f * SCREEN_WIDTH, 1.0f / 40.0f * SCREEN_HEIGHT}, // bullet size
+                                   -350.0f + (10.0f * difficulty), // bullet speed
+                                   sf::milliseconds(600 + (20 * difficulty)) // cooldown
+                                 };
+
+            case GunType::Enemy1:
+            case GunType::Enemy2:
+            case GunType::Enemy3:
+                return Model::Gun{ "Resources/Bullet.png", // bullet filename
+                                   Vector2f{1.0f / 120.0f * SCREEN_WIDTH, 1.0f / 40.0f * SCREEN_HEIGHT}, // bullet size
+                                   250.0f + (15 * difficulty), // bullet speed
+                                   sf::milliseconds(0), // cooldown
+                                   80.0f * difficulty // Chance of firing per second
+                                 };
+
+            default:
+                throw std::logic_error("Firing an unknown gun type.");
+        };
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    BulletSpawnList StressEntityFactory::createBullets(unsigned int)
+    {
+        auto bullets = BulletSpawnList();
+        bullets.reserve(m_bullets);
+
+        // The golden ratio spreads the bullets evenly without placing them in a visible pattern
+        const double goldenRatio = 0.6180339887;
+        for (unsigned int i = 0; i < m_bullets; ++i)
+        {
+            const float x = static_cast<float>(std::fmod(i * goldenRatio, 1.0));
+            const float y = (i + 0.5f) / m_bullets;
+
+            bullets.push_back(BulletSpawn{GunType::Enemy1, Vector2f{BULLET_AREA.left + (x * BULLET_AREA.width), BULLET_AREA.top + (y * BULLET_AREA.height)}});
+        }
+
+        return bullets;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
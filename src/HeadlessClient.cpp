@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <cmath>
+#include <limits>
+#include <SpaceInvaders/HeadlessClient.hpp>
+#include <SpaceInvaders/Factory/StressEntityFactory.hpp>
+#include <SpaceInvaders/Model/EntityStore.hpp>
+#include <SpaceInvaders/Model/Entities.hpp>
+
+namespace Game
+{
+    namespace
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // Create the same factory as the one that was used in the recorded session
+        EntityFactoryCreator createRecordedFactory(const InputRecording& recording)
+        {
+            auto options = recording.getLevelOptions();
+            auto createFactory = StressEntityFactory::parseArguments(options);
+            if (!options.empty())
+                throw std::runtime_error("The input recording was made with unknown level options.");
+
+            return createFactory ? createFactory : makeFactoryCreator(LevelEntityFactory{LEVEL_FILENAME});
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    HeadlessClient::HeadlessClient(std::uint64_t seed, PlayerType playerType, EntityFactoryCreator createFactory) :
+        m_seed         (seed),
+        m_playerType   (playerType),
+        m_random       (seed),
+        m_createFactory(createFactory ? std::move(createFactory) : makeFactoryCreator(LevelEntityFactory{LEVEL_FILENAME})),
+        m_view         (new View::NullView{})
+    {
+        loadNextLevel();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    HeadlessClient::HeadlessClient(const InputRecording& recording) :
+        m_seed         (recording.getSeed()),
+        m_playerType   (PlayerType::Replay),
+        m_random       (recording.getSeed()),
+        m_createFactory(createRecordedFactory(recording)),
+        m_view         (new View::NullView{}),
+        m_recording    (&recording)
+    {
+        loadNextLevel();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void HeadlessClient::run(unsigned int ticks, const sf::Time& tickTime)
+    {
+        for (unsigned int i = 0; i < ticks; ++i)
+        {
+            tick(tickTime);
+
+            if (m_gameOver)
+            {
+                m_gamesLost++;
+                m_difficulty = 0;
+                m_score = 0;
+                loadNextLevel();
+            }
+            else if (m_levelComplete)
+            {
+                m_levelsCompleted++;
+                loadNextLevel();
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    GameResult HeadlessClient::playGame(unsigned int maxTicks, const sf::Time& tickTime)
+    {
+        unsigned int ticks = 0;
+        while (ticks < maxTicks)
+        {
+            tick(tickTime);
+            ticks++;
+
+            if (m_gameOver)
+                break;
+
+            if (m_levelComplete)
+            {
+                m_levelsCompleted++;
+                loadNextLevel();
+            }
+        }
+
+        return GameResult{m_seed, m_score, m_difficulty, tickTime * static_cast<float>(ticks), m_gameOver};
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    unsigned int HeadlessClient::getScore() const
+    {
+        return m_score;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    unsigned int HeadlessClient::getLevelsCompleted() const
+    {
+        return m_levelsCompleted;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    unsigned int HeadlessClient::getGamesLost() const
+    {
+        return m_gamesLost;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::uint64_t HeadlessClient::getTotalScore() const
+    {
+        return m_totalScore;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void HeadlessClient::tick(const sf::Time& tickTime)
+    {
+        if (m_playerType == PlayerType::AI)
+            updateAI();
+        else if (m_playerType == PlayerType::Replay)
+            updateReplay();
+
+        m_view->handleEvents();
+        m_controller->update(tickTime);
+        m_tick++;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void HeadlessClient::loadNextLevel()
+    {
+        m_difficulty++;
+        m_levelComplete = false;
+        m_gameOver = false;
+        m_aiDirection = 0;
+
+        // The view is reused, only the entities of the previous level are removed from it
+        m_controller = nullptr;
+        m_view->resetScene(GameState::Playing, m_score);
+        m_controller = std::unique_ptr<Controller::Controller>(new Controller::Controller{m_view.get(), m_difficulty, m_random.split(), m_createFactory()});
+
+        m_controller->addObserver([this](const Event&){ m_levelComplete = true; }, Event::Type::LevelComplete);
+        m_controller->addObserver([this](const Event&){ m_gameOver = true; }, Event::Type::GameOver);
+        m_controller->addObserver([this](const Event& event){ m_score += event.score; m_totalScore += event.score; }, Event::Type::ScoreChanged);
+
+        // The player keeps firing during the whole level, unless the recorded keys are used
+        if (m_playerType != PlayerType::Replay)
+            m_view->queueEvent(Event{Event::Type::FireKeyPressed});
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void HeadlessClient::updateAI()
+    {
+        const Model::EntityStore& store = m_controller->getEntityStore();
+        const std::vector<EntityType>& types = store.getTypes();
+        const std::vector<unsigned char>& alive = store.getAlive();
+        const std::vector<float>& speeds = store.getSpeeds();
+        const std::vector<Vector2f>& positions = store.getPositions();
+        const std::vector<Vector2f>& sizes = store.getSizes();
+
+        std::size_t playerId = store.getIdCount();
+        for (std::size_t id = 0; id < store.getIdCount(); ++id)
+        {
+            if (alive[id] && (types[id] == EntityType::Player))
+            {
+                playerId = id;
+                break;
+            }
+        }
+
+        if (playerId == store.getIdCount())
+            return;
+
+        const Vector2f playerPosition = positions[playerId];
+        const Vector2f playerSize = sizes[playerId];
+        const float playerCenter = playerPosition.x + (playerSize.x / 2);
+
+        // Look for the nearest enemy bullet that is going to hit the player and for the nearest enemy
+        float bulletDistance = std::numeric_limits<float>::max();
+        float bulletCenter = 0;
+        float enemyDistance = std::numeric_limits<float>::max();
+        float enemyCenter = playerCenter;
+        for (std::size_t id = 0; id < store.getIdCount(); ++id)
+        {
+            if (!alive[id])
+                continue;
+
+            if ((types[id] == EntityType::Bullet) && (speeds[id] > 0))
+            {
+                const Vector2f position = positions[id];
+                const Vector2f size = sizes[id];
+
+                // Bullets that are far above the player or that will miss it by a lot are ignored
+                const float distance = playerPosition.y - position.y;
+                if ((distance < 0) || (distance > playerSize.y * 4) || (distance > bulletDistance))
+                    continue;
+                if ((position.x + size.x < playerPosition.x - playerSize.x / 2)
+                 || (position.x > playerPosition.x + playerSize.x * 1.5f))
+                    continue;
+
+                bulletDistance = distance;
+                bulletCenter = position.x + (size.x / 2);
+            }
+            else if (types[id] == EntityType::Enemy)
+            {
+                const float center = positions[id].x + (sizes[id].x / 2);
+                if (std::abs(center - playerCenter) < enemyDistance)
+                {
+                    enemyDistance = std::abs(center - playerCenter);
+                    enemyCenter = center;
+                }
+            }
+        }
+
+        int direction = 0;
+        if (bulletDistance < std::numeric_limits<float>::max())
+        {
+            // Move away from the bullet, unless the player is already standing against the side of the screen
+            direction = (bulletCenter < playerCenter) ? 1 : -1;
+            if ((direction > 0) && (playerPosition.x + playerSize.x >= SCREEN_WIDTH - 1))
+                direction = -1;
+            else if ((direction < 0) && (playerPosition.x <= 1))
+                direction = 1;
+        }
+        else if (enemyDistance > playerSize.x / 4)
+            direction = (enemyCenter < playerCenter) ? -1 : 1;
+
+        if (direction == m_aiDirection)
+            return;
+
+        if (m_aiDirection < 0)
+            m_view->queueEvent(Event{Event::Type::MoveLeftKeyReleased});
+        else if (m_aiDirection > 0)
+            m_view->queueEvent(Event{Event::Type::MoveRightKeyReleased});
+
+        if (direction < 0)
+            m_view->queueEvent(Event{Event::Type::MoveLeftKeyPressed});
+        else if (direction > 0)
+            m_view->queueEvent(Event{Event::Type::MoveRightKeyPressed});
+
+        m_aiDirection = direction;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void HeadlessClient::updateReplay()
+    {
+        // The client handled the keys after the previous tick, which is the same moment as right before this one
+        const auto& inputs = m_recording->getInputs();
+        while ((m_nextInput < inputs.size()) && (inputs[m_nextInput].tick <= m_tick))
+        {
+            m_view->queueEvent(Event{inputs[m_nextInput].type});
+            m_nextInput++;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <iostream>
+#include <string>
+#include <SpaceInvaders/HeadlessClient.hpp>
+#include <SpaceInvaders/Factory/StressEntityFactory.hpp>
+#include <SpaceInvaders/Profiler.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // The stress test option can be placed anywhere, the other arguments are positional
+        std::vector<std::string> arguments{argv + 1, argv + argc};
+        Game::EntityFactoryCreator createFactory = Game::StressEntityFactory::parseArguments(arguments);
+
+        unsigned int ticks = 100000;
+        unsigned int ticksPerSecond = 60;
+
+        if (arguments.size() > 0)
+            ticks = std::stoul(arguments[0]);
+        if (arguments.size() > 1)
+            ticksPerSecond = std::stoul(arguments[1]);
+
+        if ((arguments.size() > 3) || (ticksPerSecond == 0))
+        {
+            std::cout << "Usage: " << argv[0] << " [ticks] [ticks per second] [profile csv] [--stress enemies walls bullets]" << std::endl;
+            return 1;
+        }
+
+        // The timers are only enabled when the results are wanted, they would influence the measurement
+        const std::string profileFilename = (arguments.size() > 2) ? arguments[2] : "";
+        Game::Profiler::setEnabled(!profileFilename.empty());
+
+        Game::HeadlessClient client{0, Game::HeadlessClient::PlayerType::Scripted, createFactory};
+
+        sf::Clock clock;
+        client.run(ticks, sf::seconds(1.0f / ticksPerSecond));
+        float elapsedSeconds = clock.getElapsedTime().asSeconds();
+
+        std::cout << "Simulated " << ticks << " ticks (" << (static_cast<float>(ticks) / ticksPerSecond) << "s of game time) in " << elapsedSeconds << "s" << std::endl;
+        std::cout << "Ticks per second: " << (elapsedSeconds > 0 ? ticks / elapsedSeconds : 0) << std::endl;
+        std::cout << "Levels completed: " << client.getLevelsCompleted() << ", games lost: " << client.getGamesLost() << std::endl;
+
+        if (!profileFilename.empty())
+            Game::Profiler::writeCsv(profileFilename);
+        return 0;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception trown: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cout << "Unknown exception trown." << std::endl;
+        return 1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
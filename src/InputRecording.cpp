@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <SpaceInvaders/InputRecording.hpp>
+
+namespace Game
+{
+    namespace
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // The first bytes of every recording, the last byte is the version of the format
+        const char FILE_MAGIC[] = {'S', 'I', 'R', 2};
+
+        // The key events, their index in this list is what gets stored in the file
+        const Event::Type INPUT_EVENTS[] = { Event::Type::MoveLeftKeyPressed,  Event::Type::MoveLeftKeyReleased,
+                                             Event::Type::MoveRightKeyPressed, Event::Type::MoveRightKeyReleased,
+                                             Event::Type::FireKeyPressed,      Event::Type::FireKeyReleased };
+
+        // Amount of bits needed to store the index of a key event
+        const unsigned int INPUT_BITS = 3;
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void writeVarInt(std::vector<char>& buffer, std::uint64_t value)
+        {
+            // Seven bits per byte, the highest bit tells whether another byte follows
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+
+            buffer.push_back(static_cast<char>(value));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::uint64_t readVarInt(const std::vector<char>& buffer, std::size_t& position)
+        {
+            std::uint64_t value = 0;
+            for (unsigned int shift = 0; shift < 64; shift += 7)
+            {
+                if (position >= buffer.size())
+                    throw std::runtime_error("Unexpected end of the input recording.");
+
+                const auto byte = static_cast<unsigned char>(buffer[position++]);
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0)
+                    return value;
+            }
+
+            throw std::runtime_error("Invalid number in the input recording.");
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    InputRecording::InputRecording(std::uint64_t seed, const sf::Time& tickTime, const std::vector<std::string>& levelOptions) :
+        m_seed        (seed),
+        m_tickTime    (tickTime),
+        m_levelOptions(levelOptions)
+    {
+        if (tickTime <= sf::Time::Zero)
+            throw std::logic_error("Inputs can only be recorded when the game is updated with a fixed time.");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void InputRecording::addInput(std::uint32_t tick, Event::Type type)
+    {
+        if (!isInputEvent(type))
+            throw std::logic_error("Only key events can be added to an input recording.");
+
+        if (!m_inputs.empty() && (tick < m_inputs.back().tick))
+            throw std::logic_error("The inputs have to be added to the recording in the order in which they occurred.");
+
+        m_inputs.push_back(Input{tick, type});
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void InputRecording::finish(std::uint32_t tickCount, std::uint64_t totalScore)
+    {
+        m_tickCount = tickCount;
+        m_totalScore = totalScore;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void InputRecording::saveToFile(const std::string& filename) const
+    {
+        std::vector<char> buffer{std::begin(FILE_MAGIC), std::end(FILE_MAGIC)};
+        writeVarInt(buffer, m_seed);
+        writeVarInt(buffer, m_tickTime.asMicroseconds());
+        writeVarInt(buffer, m_tickCount);
+        writeVarInt(buffer, m_totalScore);
+
+        writeVarInt(buffer, m_levelOptions.size());
+        for (const auto& option : m_levelOptions)
+        {
+            writeVarInt(buffer, option.size());
+            buffer.insert(buffer.end(), option.begin(), option.end());
+        }
+
+        writeVarInt(buffer, m_inputs.size());
+
+        std::uint32_t previousTick = 0;
+        for (const auto& input : m_inputs)
+        {
+            const auto index = std::find(std::begin(INPUT_EVENTS), std::end(INPUT_EVENTS), input.type) - std::begin(INPUT_EVENTS);
+            writeVarInt(buffer, (static_cast<std::uint64_t>(input.tick - previousTick) << INPUT_BITS) | index);
+            previousTick = input.tick;
+        }
+
+        std::ofstream file{filename, std::ios::binary};
+        if (!file.write(buffer.data(), buffer.size()))
+            throw std::runtime_error("Failed to write the input recording to '" + filename + "'.");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void InputRecording::loadFromFile(const std::string& filename)
+    {
+        std::ifstream file{filename, std::ios::binary};
+        if (!file)
+            throw std::runtime_error("Failed to open the input recording '" + filename + "'.");
+
+        const std::vector<char> buffer{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+        if ((buffer.size() < sizeof(FILE_MAGIC)) || !std::equal(std::begin(FILE_MAGIC), std::end(FILE_MAGIC), buffer.begin()))
+            throw std::runtime_error("'" + filename + "' is not an input recording or was made by another version of the game.");
+
+        std::size_t position = sizeof(FILE_MAGIC);
+        m_seed = readVarInt(buffer, position);
+        m_tickTime = sf::microseconds(readVarInt(buffer, position));
+        m_tickCount = readVarInt(buffer, position);
+        m_totalScore = readVarInt(buffer, position);
+
+        const std::uint64_t optionCount = readVarInt(buffer, position);
+        if (optionCount > buffer.size() - position)
+            throw std::runtime_error("Unexpected end of the input recording.");
+
+        m_levelOptions.clear();
+        for (std::uint64_t i = 0; i < optionCount; ++i)
+        {
+            const std::uint64_t length = readVarInt(buffer, position);
+            if (length > buffer.size() - position)
+                throw std::runtime_error("Unexpected end of the input recording.");
+
+            m_levelOptions.emplace_back(buffer.begin() + position, buffer.begin() + position + length);
+            position += length;
+        }
+
+        const std::uint64_t inputCount = readVarInt(buffer, position);
+        if (inputCount > buffer.size() - position)
+            throw std::runtime_error("Unexpected end of the input recording.");
+
+        m_inputs.clear();
+        m_inputs.reserve(inputCount);
+
+        std::uint32_t tick = 0;
+        for (std::uint64_t i = 0; i < inputCount; ++i)
+        {
+            const std::uint64_t value = readVarInt(buffer, position);
+            const std::uint64_t index = value & ((1 << INPUT_BITS) - 1);
+            if (index >= std::extent<decltype(INPUT_EVENTS)>::value)
+                throw std::runtime_error("Invalid input in the input recording.");
+
+            tick += static_cast<std::uint32_t>(value >> INPUT_BITS);
+            m_inputs.push_back(Input{tick, INPUT_EVENTS[index]});
+        }
+
+        if (m_tickTime <= sf::Time::Zero)
+            throw std::runtime_error("Invalid tick time in the input recording.");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::uint64_t InputRecording::getSeed() const
+    {
+        return m_seed;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    sf::Time InputRecording::getTickTime() const
+    {
+        return m_tickTime;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::uint32_t InputRecording::getTickCount() const
+    {
+        return m_tickCount;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::uint64_t InputRecording::getTotalScore() const
+    {
+        return m_totalScore;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const std::vector<std::string>& InputRecording::getLevelOptions() const
+    {
+        return m_levelOptions;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const std::vector<InputRecording::Input>& InputRecording::getInputs() const
+    {
+        return m_inputs;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    bool InputRecording::isInputEvent(Event::Type type)
+    {
+        return std::find(std::begin(INPUT_EVENTS), std::end(INPUT_EVENTS), type) != std::end(INPUT_EVENTS);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -22,7 +22,11 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <algorithm>
+#include <cmath>
 #include <SpaceInvaders/Model/Entities.hpp>
+#include <SpaceInvaders/Model/Formation.hpp>
+#include <SpaceInvaders/Collision.hpp>
 
 namespace Game
 {
@@ -39,14 +43,29 @@ namespace Game
 
         Entity::~Entity()
         {
+            leaveFormation();
+            detachFromStore();
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         void Entity::setPosition(const Vector2f& position)
         {
-            m_area.left = position.x;
-            m_area.top = position.y;
+            if (m_formation)
+            {
+                m_area.left = position.x - m_formation->getOffset().x;
+                m_area.top = position.y - m_formation->getOffset().y;
+                m_formation->memberChanged(this);
+            }
+            else
+            {
+                m_area.left = position.x;
+                m_area.top = position.y;
+            }
+
+            // The formation calculates the position on the screen in the same way when it moves
+            if (m_store)
+                m_store->setPosition(m_storeId, getPosition());
 
             Event event{Event::Type::PositionChanged, this};
             event.position = position;
@@ -56,6 +75,16 @@ namespace Game
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         Vector2f Entity::getPosition() const
+        {
+            if (m_formation)
+                return Vector2f{m_area.left + m_formation->getOffset().x, m_area.top + m_formation->getOffset().y};
+            else
+                return Vector2f{m_area.left, m_area.top};
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        Vector2f Entity::getLocalPosition() const
         {
             return Vector2f{m_area.left, m_area.top};
         }
@@ -67,6 +96,12 @@ namespace Game
             m_area.width = size.x;
             m_area.height = size.y;
 
+            if (m_formation)
+                m_formation->memberChanged(this);
+
+            if (m_store)
+                m_store->setSize(m_storeId, size);
+
             Event event{Event::Type::SizeChanged, this};
             event.position = size;
             notifyObservers(event);
@@ -81,20 +116,165 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        std::string Entity::getImageFilename() const
+        FloatRect Entity::getBounds() const
+        {
+            const Vector2f position = getPosition();
+            return FloatRect{position.x, position.y, m_area.width, m_area.height};
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Entity::setSpeed(float speed)
+        {
+            m_speed = speed;
+
+            if (m_store)
+                m_store->setSpeed(m_storeId, speed);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        float Entity::getSpeed() const
+        {
+            return m_speed;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const std::string& Entity::getImageFilename() const
         {
             return m_imageFilename;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+        void Entity::setVisible(bool visible)
+        {
+            m_visible = visible;
+
+            if (m_store)
+                m_store->setAlive(m_storeId, visible);
+
+            Event event{Event::Type::VisibilityChanged, this};
+            event.visible = visible;
+            notifyObservers(event);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        bool Entity::isVisible() const
+        {
+            return m_visible;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
         void Entity::destroy()
         {
+            if (m_store)
+                m_store->setAlive(m_storeId, false);
+
             notifyObservers(Event{Event::Type::Destroyed, this});
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+        void Entity::attachToStore(EntityStore& store)
+        {
+            detachFromStore();
+
+            m_storeId = store.add(this);
+            m_store = &store;
+
+            if (m_formation)
+                m_formation->memberChanged(this);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Entity::detachFromStore()
+        {
+            if (m_store)
+            {
+                m_store->remove(m_storeId);
+                m_store = nullptr;
+
+                if (m_formation)
+                    m_formation->memberChanged(this);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        EntityStore* Entity::getStore() const
+        {
+            return m_store;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        EntityId Entity::getStoreId() const
+        {
+            return m_storeId;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Entity::joinFormation(Formation& formation)
+        {
+            leaveFormation();
+
+            const Vector2f position = getPosition();
+            m_area.left = position.x - formation.getOffset().x;
+            m_area.top = position.y - formation.getOffset().y;
+            m_formation = &formation;
+
+            formation.addMember(this);
+
+            // Rounding can make the position on the screen differ slightly from the one before joining
+            if (m_store)
+                m_store->setPosition(m_storeId, getPosition());
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Entity::leaveFormation()
+        {
+            if (m_formation)
+            {
+                const Vector2f position = getPosition();
+                Formation* formation = m_formation;
+
+                m_area.left = position.x;
+                m_area.top = position.y;
+                m_formation = nullptr;
+
+                formation->removeMember(this);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        Formation* Entity::getFormation() const
+        {
+            return m_formation;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Entity::setFormationIndex(std::size_t index)
+        {
+            m_formationIndex = index;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::size_t Entity::getFormationIndex() const
+        {
+            return m_formationIndex;
+        }
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
         AttackingEntity::AttackingEntity(const std::string& filename, const Gun& gun) :
             Entity (filename),
             m_gun  (gun)
@@ -114,25 +294,136 @@ namespace Game
             return m_gun;
         }
 
+
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        void AttackingEntity::setSpeed(float speed)
+        WallEntity::WallEntity(const std::string& filename) :
+            Entity(filename)
         {
-            m_speed = speed;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        float AttackingEntity::getSpeed() const
+        EntityType WallEntity::getType() const
         {
-            return m_speed;
+            return EntityType::Wall;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        WallEntity::WallEntity(const std::string& filename) :
-            Entity(filename)
+        BunkerEntity::BunkerEntity(const std::string& filename, unsigned int columns, unsigned int rows, const Vector2f& cellSize) :
+            Entity    (filename),
+            m_columns (columns),
+            m_cellSize(cellSize)
+        {
+            if ((columns == 0) || (columns > MAX_COLUMNS) || (rows == 0))
+                throw std::logic_error("A bunker needs between 1 and 64 columns and at least one row.");
+
+            m_cells.assign(rows, getColumnMask(0, columns - 1));
+            setSize(Vector2f{columns * cellSize.x, rows * cellSize.y});
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        EntityType BunkerEntity::getType() const
+        {
+            return EntityType::Wall;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void BunkerEntity::removeCells(unsigned int column, unsigned int row, unsigned int columns, unsigned int rows)
+        {
+            if ((column >= m_columns) || (row >= m_cells.size()) || (columns == 0) || (rows == 0))
+                return;
+
+            const std::uint64_t mask = ~getColumnMask(column, std::min(column + columns, m_columns) - 1);
+            const std::size_t lastRow = std::min<std::size_t>(row + rows, m_cells.size());
+            for (std::size_t i = row; i < lastRow; ++i)
+                m_cells[i] &= mask;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        bool BunkerEntity::erode(const FloatRect& bounds)
         {
+            unsigned int left, top, right, bottom;
+            if (!getCellRange(bounds, left, top, right, bottom))
+                return false;
+
+            const std::uint64_t mask = getColumnMask(left, right);
+
+            bool hit = false;
+            for (unsigned int row = top; row <= bottom; ++row)
+                hit |= ((m_cells[row] & mask) != 0);
+
+            if (!hit)
+                return false;
+
+            // The bullet only just entered the bunker, so the crater is made larger than the bullet itself.
+            // With this size the bunkers protect the player about as well as the blocks of walls they replaced.
+            const FloatRect crater{bounds.left - bounds.width, bounds.top - bounds.height, bounds.width * 3, bounds.height * 3};
+            if (getCellRange(crater, left, top, right, bottom))
+                removeCells(left, top, right - left + 1, bottom - top + 1);
+
+            notifyObservers(Event{Event::Type::BunkerDamaged, this});
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        unsigned int BunkerEntity::getColumns() const
+        {
+            return m_columns;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        Vector2f BunkerEntity::getCellSize() const
+        {
+            return m_cellSize;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const std::vector<std::uint64_t>& BunkerEntity::getCells() const
+        {
+            return m_cells;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        bool BunkerEntity::getCellRange(const FloatRect& area, unsigned int& left, unsigned int& top, unsigned int& right, unsigned int& bottom) const
+        {
+            if (!Collision::overlaps(area, getBounds()))
+                return false;
+
+            const Vector2f position = getPosition();
+            const int lastColumn = static_cast<int>(m_columns) - 1;
+            const int lastRow = static_cast<int>(m_cells.size()) - 1;
+
+            const int firstColumn = std::max(static_cast<int>(std::floor((area.left - position.x) / m_cellSize.x)), 0);
+            const int endColumn = std::min(static_cast<int>(std::ceil((area.left + area.width - position.x) / m_cellSize.x)) - 1, lastColumn);
+            const int firstRow = std::max(static_cast<int>(std::floor((area.top - position.y) / m_cellSize.y)), 0);
+            const int endRow = std::min(static_cast<int>(std::ceil((area.top + area.height - position.y) / m_cellSize.y)) - 1, lastRow);
+
+            // Rounding can leave nothing when the area only just touches the bunker
+            if ((firstColumn > endColumn) || (firstRow > endRow))
+                return false;
+
+            left = static_cast<unsigned int>(firstColumn);
+            top = static_cast<unsigned int>(firstRow);
+            right = static_cast<unsigned int>(endColumn);
+            bottom = static_cast<unsigned int>(endRow);
+            return true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::uint64_t BunkerEntity::getColumnMask(unsigned int firstColumn, unsigned int lastColumn)
+        {
+            // Shifting by 64 isn't defined, so the mask is made by shifting the full row to the right
+            return (~std::uint64_t{0} >> (MAX_COLUMNS - 1 - (lastColumn - firstColumn))) << firstColumn;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -145,6 +436,13 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+        EntityType EnemyEntity::getType() const
+        {
+            return EntityType::Enemy;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
         unsigned int EnemyEntity::getKillPoints() const
         {
             return m_killPoints;
@@ -170,6 +468,13 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+        EntityType PlayerEntity::getType() const
+        {
+            return EntityType::Player;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
         void PlayerEntity::setLives(unsigned int lives)
         {
             m_lives = lives;
@@ -185,16 +490,16 @@ namespace Game
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         BulletEntity::BulletEntity(const std::string& filename, float speed) :
-            Entity (filename),
-            m_speed(speed)
+            Entity(filename)
         {
+            m_speed = speed;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        float BulletEntity::getSpeed() const
+        EntityType BulletEntity::getType() const
         {
-            return m_speed;
+            return EntityType::Bullet;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <SpaceInvaders/Model/EntityStore.hpp>
+#include <SpaceInvaders/Model/Entities.hpp>
+
+namespace Game
+{
+    namespace Model
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        EntityStore::~EntityStore()
+        {
+            for (auto& entity : m_entities)
+            {
+                if (entity != nullptr)
+                    entity->detachFromStore();
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        EntityId EntityStore::add(Entity* entity)
+        {
+            EntityId id;
+            if (!m_freeIds.empty())
+            {
+                id = m_freeIds.back();
+                m_freeIds.pop_back();
+            }
+            else
+            {
+                id = static_cast<EntityId>(m_entities.size());
+
+                m_positions.push_back(Vector2f{0, 0});
+                m_sizes.push_back(Vector2f{0, 0});
+                m_speeds.push_back(0);
+                m_types.push_back(entity->getType());
+                m_alive.push_back(false);
+                m_entities.push_back(nullptr);
+            }
+
+            m_positions[id] = entity->getPosition();
+            m_sizes[id] = entity->getSize();
+            m_speeds[id] = entity->getSpeed();
+            m_types[id] = entity->getType();
+            m_alive[id] = entity->isVisible();
+            m_entities[id] = entity;
+            return id;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void EntityStore::remove(EntityId id)
+        {
+            m_alive[id] = false;
+            m_entities[id] = nullptr;
+            m_freeIds.push_back(id);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void EntityStore::setSize(EntityId id, const Vector2f& size)
+        {
+            m_sizes[id] = size;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void EntityStore::setSpeed(EntityId id, float speed)
+        {
+            m_speeds[id] = speed;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void EntityStore::setAlive(EntityId id, bool alive)
+        {
+            m_alive[id] = alive;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::size_t EntityStore::getIdCount() const
+        {
+            return m_entities.size();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const std::vector<Vector2f>& EntityStore::getPositions() const
+        {
+            return m_positions;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const std::vector<Vector2f>& EntityStore::getSizes() const
+        {
+            return m_sizes;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const std::vector<float>& EntityStore::getSpeeds() const
+        {
+            return m_speeds;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const std::vector<EntityType>& EntityStore::getTypes() const
+        {
+            return m_types;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const std::vector<unsigned char>& EntityStore::getAlive() const
+        {
+            return m_alive;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const std::vector<Entity*>& EntityStore::getEntities() const
+        {
+            return m_entities;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <algorithm>
+#include <SpaceInvaders/Model/Formation.hpp>
+#include <SpaceInvaders/Model/Entities.hpp>
+
+namespace Game
+{
+    namespace Model
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        Formation::~Formation()
+        {
+            // Copy the list because leaving the formation removes the entity from it
+            std::vector<Entity*> members;
+            for (const auto& member : m_members)
+                members.push_back(member.entity);
+
+            for (auto& member : members)
+                member->leaveFormation();
+
+            notifyObservers(Event{Event::Type::Destroyed});
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Formation::addMember(Entity* entity)
+        {
+            entity->setFormationIndex(m_members.size());
+            m_members.push_back(Member{entity, entity->getStore(), entity->getStoreId(), entity->getLocalPosition()});
+
+            m_boundsOutdated = true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Formation::removeMember(Entity* entity)
+        {
+            const std::size_t index = entity->getFormationIndex();
+            if ((index >= m_members.size()) || (m_members[index].entity != entity))
+                return;
+
+            m_members[index] = m_members.back();
+            m_members[index].entity->setFormationIndex(index);
+            m_members.pop_back();
+
+            m_boundsOutdated = true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Formation::setOffset(const Vector2f& offset)
+        {
+            m_offset = offset;
+
+            // The store keeps the positions on the screen, which changed for all members
+            for (const auto& member : m_members)
+            {
+                if (member.store)
+                    member.store->setPosition(member.storeId, Vector2f{member.localPosition.x + offset.x, member.localPosition.y + offset.y});
+            }
+
+            Event event{Event::Type::PositionChanged};
+            event.position = offset;
+            notifyObservers(event);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const Vector2f& Formation::getOffset() const
+        {
+            return m_offset;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Formation::setDirection(float direction)
+        {
+            m_direction = direction;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        float Formation::getDirection() const
+        {
+            return m_direction;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        FloatRect Formation::getBounds() const
+        {
+            if (m_boundsOutdated)
+                updateBounds();
+
+            return FloatRect{m_localBounds.left + m_offset.x, m_localBounds.top + m_offset.y, m_localBounds.width, m_localBounds.height};
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        bool Formation::isEmpty() const
+        {
+            return m_members.empty();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Formation::memberChanged(Entity* entity)
+        {
+            const std::size_t index = entity->getFormationIndex();
+            if ((index >= m_members.size()) || (m_members[index].entity != entity))
+                return;
+
+            m_members[index] = Member{entity, entity->getStore(), entity->getStoreId(), entity->getLocalPosition()};
+            m_boundsOutdated = true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Formation::updateBounds() const
+        {
+            m_boundsOutdated = false;
+
+            if (m_members.empty())
+            {
+                m_localBounds = FloatRect{0, 0, 0, 0};
+                return;
+            }
+
+            Vector2f topLeft = m_members.front().localPosition;
+            Vector2f bottomRight = Vector2f{topLeft.x + m_members.front().entity->getSize().x, topLeft.y + m_members.front().entity->getSize().y};
+            for (auto& member : m_members)
+            {
+                const Vector2f& position = member.localPosition;
+                const Vector2f size = member.entity->getSize();
+
+                topLeft.x = std::min(topLeft.x, position.x);
+                topLeft.y = std::min(topLeft.y, position.y);
+                bottomRight.x = std::max(bottomRight.x, position.x + size.x);
+                bottomRight.y = std::max(bottomRight.y, position.y + size.y);
+            }
+
+            m_localBounds = FloatRect{topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y};
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -41,7 +41,7 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        std::string Gun::getBulletFilename() const
+        const std::string& Gun::getBulletFilename() const
         {
             return m_bulletFilename;
         }
@@ -83,11 +83,11 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        bool Gun::tryToFire()
+        bool Gun::tryToFire(const sf::Time& currentTime, float fireRateFactor)
         {
-            if (m_cooldownTimer.getElapsedTime() > m_coolDownTime)
+            if (currentTime - m_lastFireTime > m_coolDownTime / fireRateFactor)
             {
-                m_cooldownTimer.restart();
+                m_lastFireTime = currentTime;
                 return true;
             }
             else
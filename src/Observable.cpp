@@ -22,10 +22,41 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+
 #include <SpaceInvaders/Observable.hpp>
+#include <algorithm>
 
 namespace Game
 {
+    namespace
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // Increases the dispatch depth while it exists, so the depth is restored when an observer throws
+        class DispatchDepthGuard
+        {
+        public:
+            explicit DispatchDepthGuard(unsigned int& depth) :
+                m_depth(depth)
+            {
+                ++m_depth;
+            }
+
+            ~DispatchDepthGuard()
+            {
+                --m_depth;
+            }
+
+            DispatchDepthGuard(const DispatchDepthGuard&) = delete;
+            DispatchDepthGuard& operator=(const DispatchDepthGuard&) = delete;
+
+        private:
+            unsigned int& m_depth;
+        };
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     Observable::~Observable()
@@ -34,24 +65,137 @@ namespace Game
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    void Observable::addObserver(std::function<void(const Event&)> function, Event::Type eventType)
+    Observable::ObserverHandle Observable::addObserver(std::function<void(const Event&)> function, Event::Type eventType)
     {
-        m_observers[eventType].push_back(function);
+        if (eventType >= Event::Type::Count)
+            throw std::logic_error("Can't add an observer for an invalid event type.");
+
+        const unsigned int id = m_nextObserverId++;
+        m_observers[static_cast<std::size_t>(eventType)].push_back(Observer{std::move(function), id, false});
+        return ObserverHandle{eventType, id};
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Observable::removeObserver(const ObserverHandle& handle)
+    {
+        if (handle.eventType >= Event::Type::Count)
+            throw std::logic_error("Can't remove an observer for an invalid event type.");
+
+        auto& observers = m_observers[static_cast<std::size_t>(handle.eventType)];
+        for (auto it = observers.begin(); it != observers.end(); ++it)
+        {
+            if (it->id == handle.id)
+            {
+                // The observer might be running right now, so it can't be erased yet
+                if (m_dispatchDepth > 0)
+                {
+                    it->removed = true;
+                    m_observersRemoved = true;
+                }
+                else
+                    observers.erase(it);
+
+                return;
+            }
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     void Observable::clearObservers()
     {
-        m_observers.clear();
+        if (m_dispatchDepth > 0)
+        {
+            for (auto& observers : m_observers)
+            {
+                for (auto& observer : observers)
+                    observer.removed = true;
+            }
+
+            m_observersRemoved = true;
+        }
+        else
+        {
+            for (auto& observers : m_observers)
+                observers.clear();
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    void Observable::notifyObservers(const Event& event)
+    void Observable::setEventQueueing(bool enabled)
     {
-        for (auto& function : m_observers[event.type])
-            function(event);
+        m_queueEvents = enabled;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Observable::dispatchQueuedEvents()
+    {
+        static_assert(static_cast<std::size_t>(Event::Type::Count) <= 32, "Every event type needs a bit in m_queuedTypes.");
+
+        while (!m_queuedEvents.empty())
+        {
+            // Observers may queue new events, those are handled in the next round
+            const std::size_t count = m_queuedEvents.size();
+            std::uint32_t types = m_queuedTypes;
+            m_queuedTypes = 0;
+
+            for (unsigned int type = 0; types != 0; ++type, types >>= 1)
+            {
+                if ((types & 1) == 0)
+                    continue;
+
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    // The event is copied because the queue can grow while the observers run
+                    if (static_cast<unsigned int>(m_queuedEvents[i].type) == type)
+                    {
+                        const Event event = m_queuedEvents[i];
+                        if (!m_observers[type].empty())
+                            dispatch(event);
+                    }
+                }
+            }
+
+            m_queuedEvents.erase(m_queuedEvents.begin(), m_queuedEvents.begin() + count);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Observable::dispatch(const Event& event)
+    {
+        auto& observers = m_observers[static_cast<std::size_t>(event.type)];
+
+        // Observers that are added while dispatching won't receive this event
+        const std::size_t count = observers.size();
+
+        {
+            const DispatchDepthGuard guard{m_dispatchDepth};
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (!observers[i].removed)
+                    observers[i].function(event);
+            }
+        }
+
+        if ((m_dispatchDepth == 0) && m_observersRemoved)
+            eraseRemovedObservers();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Observable::eraseRemovedObservers()
+    {
+        for (auto& observers : m_observers)
+        {
+            observers.erase(std::remove_if(observers.begin(), observers.end(), [](const Observer& observer){ return observer.removed; }),
+                            observers.end());
+        }
+
+        m_observersRemoved = false;
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////
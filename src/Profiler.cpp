@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include <SpaceInvaders/Profiler.hpp>
+
+namespace Game
+{
+    namespace
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        // Amount of samples that are kept per phase, a few seconds worth of frames
+        const std::size_t SAMPLE_COUNT = 1024;
+
+        // The ring buffer of a single phase. Writers reserve a slot by increasing the counter, so they
+        // never have to wait for each other. The oldest samples are simply overwritten.
+        struct SampleBuffer
+        {
+            std::array<std::atomic<std::uint32_t>, SAMPLE_COUNT> samples;
+            std::atomic<std::uint64_t> count;
+        };
+
+        // Objects with static storage duration are zero-initialized, which is exactly what is needed here
+        std::array<SampleBuffer, static_cast<std::size_t>(Profiler::Phase::Count)> sampleBuffers;
+        std::atomic<bool> profilingEnabled{false};
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Profiler::ScopedTimer::ScopedTimer(Phase phase) :
+        m_phase  (phase),
+        m_enabled(Profiler::isEnabled())
+    {
+        if (m_enabled)
+            m_start = std::chrono::steady_clock::now();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Profiler::ScopedTimer::~ScopedTimer()
+    {
+        if (m_enabled)
+        {
+            const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+            addSample(m_phase, static_cast<std::uint32_t>(std::min<decltype(duration)>(duration, UINT32_MAX)));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Profiler::setEnabled(bool enabled)
+    {
+        profilingEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    bool Profiler::isEnabled()
+    {
+        return profilingEnabled.load(std::memory_order_relaxed);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Profiler::addSample(Phase phase, std::uint32_t nanoseconds)
+    {
+        SampleBuffer& buffer = sampleBuffers[static_cast<std::size_t>(phase)];
+
+        const std::uint64_t index = buffer.count.fetch_add(1, std::memory_order_relaxed);
+        buffer.samples[index % SAMPLE_COUNT].store(nanoseconds, std::memory_order_relaxed);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Profiler::Statistics Profiler::getStatistics(Phase phase)
+    {
+        const SampleBuffer& buffer = sampleBuffers[static_cast<std::size_t>(phase)];
+
+        // Copy the samples first, they may be overwritten while the statistics are being calculated
+        const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(buffer.count.load(std::memory_order_relaxed), SAMPLE_COUNT));
+        std::vector<std::uint32_t> samples(count);
+        for (std::size_t i = 0; i < count; ++i)
+            samples[i] = buffer.samples[i].load(std::memory_order_relaxed);
+
+        Statistics statistics;
+        if (samples.empty())
+            return statistics;
+
+        std::sort(samples.begin(), samples.end());
+
+        double total = 0;
+        for (const auto sample : samples)
+            total += sample;
+
+        statistics.samples = samples.size();
+        statistics.min = samples.front() / 1000.0;
+        statistics.average = total / samples.size() / 1000.0;
+        statistics.p99 = samples[(samples.size() - 1) * 99 / 100] / 1000.0;
+        statistics.max = samples.back() / 1000.0;
+        return statistics;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    const char* Profiler::getPhaseName(Phase phase)
+    {
+        switch (phase)
+        {
+            case Phase::PlayerUpdate:
+                return "PlayerUpdate";
+            case Phase::EnemyUpdate:
+                return "EnemyUpdate";
+            case Phase::PowerupUpdate:
+                return "PowerupUpdate";
+            case Phase::BulletUpdate:
+                return "BulletUpdate";
+            case Phase::HandleEvents:
+                return "HandleEvents";
+            case Phase::Draw:
+                return "Draw";
+            case Phase::Count:
+                break;
+        }
+
+        throw std::logic_error("Profiler::getPhaseName called with an invalid phase.");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Profiler::writeCsv(const std::string& filename)
+    {
+        std::ofstream file{filename};
+        file << "phase,samples,min_us,avg_us,p99_us,max_us\n";
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(Phase::Count); ++i)
+        {
+            const Statistics statistics = getStatistics(static_cast<Phase>(i));
+            file << getPhaseName(static_cast<Phase>(i)) << ',' << statistics.samples << ',' << statistics.min << ','
+                 << statistics.average << ',' << statistics.p99 << ',' << statistics.max << '\n';
+        }
+
+        if (!file)
+            throw std::runtime_error("Failed to write the profiler results to '" + filename + "'.");
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Profiler::clear()
+    {
+        for (auto& buffer : sampleBuffers)
+            buffer.count.store(0, std::memory_order_relaxed);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <chrono>
+#include <random>
+#include <SpaceInvaders/Random.hpp>
+
+namespace Game
+{
+    namespace
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::uint64_t rotateLeft(std::uint64_t value, int bits)
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::uint64_t splitMix64(std::uint64_t& state)
+        {
+            std::uint64_t result = (state += 0x9E3779B97F4A7C15ull);
+            result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ull;
+            result = (result ^ (result >> 27)) * 0x94D049BB133111EBull;
+            return result ^ (result >> 31);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Random::Random(std::uint64_t seed)
+    {
+        // splitmix64 never gives four zeros in a row, which is the only state that xoshiro can't escape from
+        for (auto& state : m_state)
+            state = splitMix64(seed);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Random Random::split()
+    {
+        Random stream = *this;
+        jump();
+        return stream;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::uint64_t Random::next()
+    {
+        const std::uint64_t result = rotateLeft(m_state[1] * 5, 7) * 9;
+        const std::uint64_t t = m_state[1] << 17;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotateLeft(m_state[3], 45);
+
+        return result;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::uint32_t Random::nextInt(std::uint32_t bound)
+    {
+        if (bound == 0)
+            return 0;
+
+        // Multiply instead of using a modulo, numbers that would make the result biased are thrown away
+        std::uint64_t product = (next() >> 32) * bound;
+        if (static_cast<std::uint32_t>(product) < bound)
+        {
+            const std::uint32_t threshold = static_cast<std::uint32_t>(-bound) % bound;
+            while (static_cast<std::uint32_t>(product) < threshold)
+                product = (next() >> 32) * bound;
+        }
+
+        return static_cast<std::uint32_t>(product >> 32);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    double Random::nextDouble()
+    {
+        // Only the upper 53 bits are used, as that is the precision of a double
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    float Random::nextFloat(float min, float max)
+    {
+        // Only the upper 24 bits are used, as that is the precision of a float
+        const float value = (next() >> 40) * (1.0f / 16777216.0f);
+        return min + (value * (max - min));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    Random::result_type Random::operator()()
+    {
+        return next();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::uint64_t Random::createSeed()
+    {
+        std::uint64_t seed = std::chrono::high_resolution_clock::now().time_since_epoch().count();
+
+        // The random device isn't random on every platform, so it is combined with the time
+        std::random_device device;
+        seed ^= (static_cast<std::uint64_t>(device()) << 32) | device();
+        return seed;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void Random::jump()
+    {
+        static const std::uint64_t jumpPolynomial[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                                        0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+
+        std::array<std::uint64_t, 4> state{{0, 0, 0, 0}};
+        for (const auto polynomial : jumpPolynomial)
+        {
+            for (int bit = 0; bit < 64; ++bit)
+            {
+                if (polynomial & (std::uint64_t{1} << bit))
+                {
+                    for (std::size_t i = 0; i < state.size(); ++i)
+                        state[i] ^= m_state[i];
+                }
+
+                next();
+            }
+        }
+
+        m_state = state;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <iostream>
+#include <string>
+#include <SpaceInvaders/HeadlessClient.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if ((argc < 2) || (argc > 3))
+        {
+            std::cout << "Usage: " << argv[0] << " recording-file [repeat]" << std::endl;
+            return 1;
+        }
+
+        Game::InputRecording recording;
+        recording.loadFromFile(argv[1]);
+
+        unsigned int repeat = 1;
+        if (argc > 2)
+            repeat = std::stoul(argv[2]);
+
+        // Replaying the same recording multiple times gives a workload that is identical every time
+        bool identical = true;
+        sf::Clock clock;
+        for (unsigned int i = 0; i < repeat; ++i)
+        {
+            Game::HeadlessClient client{recording};
+            client.run(recording.getTickCount(), recording.getTickTime());
+
+            if (client.getTotalScore() != recording.getTotalScore())
+                identical = false;
+        }
+        const float elapsedSeconds = clock.getElapsedTime().asSeconds();
+        const float ticks = static_cast<float>(recording.getTickCount()) * repeat;
+
+        std::cout << "Replayed " << recording.getInputs().size() << " inputs during " << recording.getTickCount() << " ticks "
+                  << repeat << " times in " << elapsedSeconds << "s" << std::endl;
+        std::cout << "Ticks per second: " << (elapsedSeconds > 0 ? ticks / elapsedSeconds : 0) << std::endl;
+
+        if (!identical)
+        {
+            std::cout << "The replay doesn't match the recording, the score differs from " << recording.getTotalScore() << std::endl;
+            return 1;
+        }
+
+        std::cout << "The replay matches the recording (score " << recording.getTotalScore() << ")" << std::endl;
+        return 0;
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "Exception trown: " << e.what() << std::endl;
+        return 1;
+    }
+    catch (...)
+    {
+        std::cout << "Unknown exception trown." << std::endl;
+        return 1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
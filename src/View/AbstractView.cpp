@@ -31,6 +31,15 @@ namespace Game
     {
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+        void AbstractView::resetScene(GameState, unsigned int)
+        {
+            m_entities.clear();
+            m_interpolation = 1;
+            m_sceneChanged = true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
         void AbstractView::entityDestroyed(const Event&, AbstractEntityRepresentation* representation)
         {
             for (auto it = m_entities.begin(); it != m_entities.end(); ++it)
@@ -38,6 +47,7 @@ namespace Game
                 if (it->get() == representation)
                 {
                     m_entities.erase(it);
+                    m_sceneChanged = true;
                     break;
                 }
             }
@@ -51,5 +61,22 @@ namespace Game
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void AbstractView::tickStarted()
+        {
+            m_sceneChanged = true;
+
+            for (auto& entity : m_entities)
+                entity->tickStarted();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void AbstractView::setInterpolation(float interpolation)
+        {
+            m_interpolation = interpolation;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
     }
 }
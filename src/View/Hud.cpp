@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <SpaceInvaders/View/Hud.hpp>
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        Hud::Hud(const sf::Font& font, unsigned int score) :
+            m_font               (font),
+            m_score              (score),
+            m_scoreText          ("", font, 30),
+            m_livesText          ("", font, 30),
+            m_messageText        ("", font, 30),
+            m_mainMenuHeader     (createCenteredText("Space Invaders", 72, SCREEN_HEIGHT / 3.0f)),
+            m_mainMenuInstruction(createCenteredText("[ Press return key to start playing ]", 24, SCREEN_HEIGHT * 2.0f / 3.0f)),
+            m_pausedHeader       (createCenteredText("Paused", 64, SCREEN_HEIGHT / 3.0f)),
+            m_gameOverHeader     (createCenteredText("Game Over", 64, SCREEN_HEIGHT / 3.0f)),
+            m_continueInstruction(createCenteredText("[ Press return key to continue ]", 24, SCREEN_HEIGHT * 2.0f / 3.0f))
+        {
+            m_mainMenuHeader.setColor(sf::Color::Green);
+            m_mainMenuInstruction.setColor(sf::Color::Yellow);
+
+            m_scoreText.setPosition(10, 0);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Hud::setScore(unsigned int score)
+        {
+            if (m_score != score)
+            {
+                m_score = score;
+                m_scoreDirty = true;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Hud::addScore(unsigned int points)
+        {
+            setScore(m_score + points);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Hud::setLives(unsigned int lives)
+        {
+            if (!m_livesVisible || (m_lives != lives))
+            {
+                m_lives = lives;
+                m_livesVisible = true;
+                m_livesDirty = true;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Hud::hideLives()
+        {
+            if (m_livesVisible)
+            {
+                m_livesVisible = false;
+                m_livesDirty = true;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Hud::setMessage(const std::string& message)
+        {
+            if (m_message == message)
+                return;
+
+            // Messages are rare, so the text is rebuilt immediately
+            m_message = message;
+            m_messageText.setString(message);
+            m_messageText.setPosition(sf::Vector2f{(SCREEN_WIDTH - m_messageText.getLocalBounds().width) / 2.0f, 0});
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Hud::draw(sf::RenderTarget& target, GameState gameState)
+        {
+            update();
+
+            switch (gameState)
+            {
+                case GameState::MainMenu:
+                    target.draw(m_mainMenuHeader);
+                    target.draw(m_mainMenuInstruction);
+                    break;
+
+                case GameState::Paused:
+                    target.draw(m_scoreText);
+                    target.draw(m_livesText);
+                    target.draw(m_pausedHeader);
+                    target.draw(m_continueInstruction);
+                    break;
+
+                case GameState::Playing:
+                    target.draw(m_scoreText);
+                    target.draw(m_livesText);
+                    target.draw(m_messageText);
+                    break;
+
+                case GameState::GameOver:
+                    target.draw(m_gameOverHeader);
+                    target.draw(m_gameOverScore);
+                    target.draw(m_continueInstruction);
+                    break;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void Hud::update()
+        {
+            if (m_scoreDirty)
+            {
+                const std::string score = std::to_string(m_score);
+                m_scoreText.setString(score);
+                m_gameOverScore = createCenteredText(score, 42, SCREEN_HEIGHT / 2.0f);
+                m_scoreDirty = false;
+            }
+
+            if (m_livesDirty)
+            {
+                m_livesText.setString(m_livesVisible ? "Lives: " + std::to_string(m_lives) : "");
+                m_livesText.setPosition(SCREEN_WIDTH - m_livesText.getLocalBounds().width - 10, 0);
+                m_livesDirty = false;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        sf::Text Hud::createCenteredText(const std::string& string, unsigned int characterSize, float centerY) const
+        {
+            sf::Text text{string, m_font, characterSize};
+            text.setPosition((SCREEN_WIDTH / 2.0f) - (text.getLocalBounds().width / 2.0f),
+                             centerY - (text.getLocalBounds().height / 2.0f));
+            return text;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <SpaceInvaders/View/NullView.hpp>
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void NullView::addEntity(const EntityPtr)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void NullView::handleEvents()
+        {
+            while (!m_queuedEvents.empty())
+            {
+                Event event = m_queuedEvents.front();
+                m_queuedEvents.pop_front();
+
+                notifyObservers(event);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void NullView::draw()
+        {
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void NullView::setMessage(const std::string& message)
+        {
+            m_message = message;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void NullView::removeMessage()
+        {
+            m_message.clear();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void NullView::resetScene(GameState gameState, unsigned int score)
+        {
+            AbstractView::resetScene(gameState, score);
+
+            m_queuedEvents.clear();
+            m_message.clear();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void NullView::queueEvent(const Event& event)
+        {
+            m_queuedEvents.push_back(event);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const std::string& NullView::getMessage() const
+        {
+            return m_message;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        unsigned int NullView::getLives() const
+        {
+            return m_lives;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void NullView::updateLives(unsigned int lives)
+        {
+            m_lives = lives;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <SpaceInvaders/View/SFMLBatchedEntityRepresentation.hpp>
+#include <SpaceInvaders/Model/Entities.hpp>
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        SFMLBatchedEntityRepresentation::SFMLBatchedEntityRepresentation(sf::VertexArray& vertices, TextureAtlas& atlas, EntityPtr entity) :
+            SFMLInterpolatedEntityRepresentation(entity),
+            m_vertices(vertices)
+        {
+            std::string filename = entity->getImageFilename();
+
+            if (!filename.empty())
+            {
+                sf::IntRect rect = atlas.addImage(filename);
+                m_textureRect = sf::FloatRect{static_cast<float>(rect.left), static_cast<float>(rect.top),
+                                              static_cast<float>(rect.width), static_cast<float>(rect.height)};
+                m_size = sf::Vector2f{entity->getSize().x, entity->getSize().y};
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLBatchedEntityRepresentation::draw(float interpolation)
+        {
+            // Hidden entities and entities without image are not drawn
+            if (!m_visible || (m_size.x == 0))
+                return;
+
+            const sf::Vector2f position = getInterpolatedPosition(interpolation);
+            float left = position.x;
+            float top = position.y;
+
+            float right = left + m_size.x;
+            float bottom = top + m_size.y;
+
+            float textureRight = m_textureRect.left + m_textureRect.width;
+            float textureBottom = m_textureRect.top + m_textureRect.height;
+
+            m_vertices.append(sf::Vertex{sf::Vector2f{left, top}, sf::Vector2f{m_textureRect.left, m_textureRect.top}});
+            m_vertices.append(sf::Vertex{sf::Vector2f{right, top}, sf::Vector2f{textureRight, m_textureRect.top}});
+            m_vertices.append(sf::Vertex{sf::Vector2f{right, bottom}, sf::Vector2f{textureRight, textureBottom}});
+            m_vertices.append(sf::Vertex{sf::Vector2f{left, bottom}, sf::Vector2f{m_textureRect.left, textureBottom}});
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <SpaceInvaders/View/SFMLBunkerRepresentation.hpp>
+#include <SpaceInvaders/Model/Entities.hpp>
+
+namespace Game
+{
+    namespace View
+    {
+        namespace
+        {
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+
+            // Returns the index of the lowest bit that is set, the value may not be 0
+            unsigned int countTrailingZeros(std::uint64_t value)
+            {
+#if defined(__GNUC__)
+                return static_cast<unsigned int>(__builtin_ctzll(value));
+#else
+                unsigned int count = 0;
+                while ((value & 1) == 0)
+                {
+                    value >>= 1;
+                    count++;
+                }
+                return count;
+#endif
+            }
+
+            ////////////////////////////////////////////////////////////////////////////////////////////////
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        SFMLBunkerRepresentation::SFMLBunkerRepresentation(DrawRectFunction drawRect, BunkerPtr bunker) :
+            m_drawRect(std::move(drawRect)),
+            m_position(bunker->getPosition().x, bunker->getPosition().y),
+            m_cellSize(bunker->getCellSize().x, bunker->getCellSize().y),
+            m_cells   (bunker->getCells())
+        {
+            bunker->addObserver(std::bind(&SFMLBunkerRepresentation::bunkerDamaged, this, std::placeholders::_1), Event::Type::BunkerDamaged);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLBunkerRepresentation::draw(float)
+        {
+            std::size_t row = 0;
+            while (row < m_cells.size())
+            {
+                // Rows that look the same are drawn together
+                std::size_t rows = 1;
+                while ((row + rows < m_cells.size()) && (m_cells[row + rows] == m_cells[row]))
+                    rows++;
+
+                const float top = m_position.y + (m_cellSize.y * row);
+                const float height = m_cellSize.y * rows;
+
+                std::uint64_t cells = m_cells[row];
+                while (cells != 0)
+                {
+                    // Find where the run of cells starts and how long it is, the bits below it are already cleared
+                    const unsigned int first = countTrailingZeros(cells);
+                    const std::uint64_t remaining = ~(cells >> first);
+                    const unsigned int length = (remaining == 0) ? (64 - first) : countTrailingZeros(remaining);
+
+                    m_drawRect(sf::Vector2f{m_position.x + (m_cellSize.x * first), top}, sf::Vector2f{m_cellSize.x * length, height});
+
+                    cells = (first + length >= 64) ? 0 : (cells & (~std::uint64_t{0} << (first + length)));
+                }
+
+                row += rows;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLBunkerRepresentation::bunkerDamaged(const Event& event)
+        {
+            m_cells = static_cast<Model::BunkerEntity*>(event.entity)->getCells();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <SpaceInvaders/View/SFMLInterpolatedEntityRepresentation.hpp>
+#include <SpaceInvaders/Model/Entities.hpp>
+#include <SpaceInvaders/Model/Formation.hpp>
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        SFMLInterpolatedEntityRepresentation::SFMLInterpolatedEntityRepresentation(const EntityPtr& entity)
+        {
+            // Follow the formation, the entity itself won't tell when the formation moves
+            m_formation = entity->getFormation();
+            if (m_formation)
+            {
+                m_formationOffset = sf::Vector2f{m_formation->getOffset().x, m_formation->getOffset().y};
+                m_formationObservers.push_back(m_formation->addObserver(std::bind(&SFMLInterpolatedEntityRepresentation::formationMoved, this, std::placeholders::_1), Event::Type::PositionChanged));
+                m_formationObservers.push_back(m_formation->addObserver(std::bind(&SFMLInterpolatedEntityRepresentation::formationDestroyed, this, std::placeholders::_1), Event::Type::Destroyed));
+            }
+
+            m_localPosition = sf::Vector2f{entity->getLocalPosition().x, entity->getLocalPosition().y};
+            m_currentPosition = m_localPosition + m_formationOffset;
+            m_previousPosition = m_currentPosition;
+
+            m_visible = entity->isVisible();
+
+            entity->addObserver(std::bind(&SFMLInterpolatedEntityRepresentation::positionChanged, this, std::placeholders::_1), Event::Type::PositionChanged);
+            entity->addObserver(std::bind(&SFMLInterpolatedEntityRepresentation::visibilityChanged, this, std::placeholders::_1), Event::Type::VisibilityChanged);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        SFMLInterpolatedEntityRepresentation::~SFMLInterpolatedEntityRepresentation()
+        {
+            if (m_formation)
+            {
+                for (const auto& handle : m_formationObservers)
+                    m_formation->removeObserver(handle);
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLInterpolatedEntityRepresentation::tickStarted()
+        {
+            m_previousPosition = m_currentPosition;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        sf::Vector2f SFMLInterpolatedEntityRepresentation::getInterpolatedPosition(float interpolation) const
+        {
+            return sf::Vector2f{m_previousPosition.x + ((m_currentPosition.x - m_previousPosition.x) * interpolation),
+                                m_previousPosition.y + ((m_currentPosition.y - m_previousPosition.y) * interpolation)};
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLInterpolatedEntityRepresentation::positionChanged(const Event& event)
+        {
+            m_currentPosition = sf::Vector2f{event.position.x, event.position.y};
+            m_localPosition = m_currentPosition - m_formationOffset;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLInterpolatedEntityRepresentation::visibilityChanged(const Event& event)
+        {
+            m_visible = event.visible;
+
+            // Don't slide from the place where the entity was hidden to where it is shown again
+            m_previousPosition = m_currentPosition;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLInterpolatedEntityRepresentation::formationMoved(const Event& event)
+        {
+            m_formationOffset = sf::Vector2f{event.position.x, event.position.y};
+            m_currentPosition = m_localPosition + m_formationOffset;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLInterpolatedEntityRepresentation::formationDestroyed(const Event&)
+        {
+            // The entity stays where it is, its position is no longer relative to the formation
+            m_formation = nullptr;
+            m_localPosition = m_currentPosition;
+            m_formationOffset = sf::Vector2f{0, 0};
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
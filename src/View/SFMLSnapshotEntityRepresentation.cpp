@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include <SpaceInvaders/View/SFMLSnapshotEntityRepresentation.hpp>
+#include <SpaceInvaders/Model/Entities.hpp>
+
+namespace Game
+{
+    namespace View
+    {
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        SFMLSnapshotEntityRepresentation::SFMLSnapshotEntityRepresentation(std::vector<SceneSnapshot::Sprite>& sprites, unsigned int image, EntityPtr entity) :
+            SFMLInterpolatedEntityRepresentation(entity),
+            m_sprites(sprites),
+            m_image  (image)
+        {
+            if (!entity->getImageFilename().empty())
+                m_size = sf::Vector2f{entity->getSize().x, entity->getSize().y};
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLSnapshotEntityRepresentation::draw(float)
+        {
+            // Hidden entities and entities without image are not drawn
+            if (!m_visible || (m_size.x == 0))
+                return;
+
+            m_sprites.push_back(SceneSnapshot::Sprite{m_image, m_previousPosition, m_currentPosition, m_size});
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -22,9 +22,16 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
 #include <SpaceInvaders/View/SFMLView.hpp>
-#include <SpaceInvaders/View/SFMLEntityRepresentation.hpp>
+#include <SpaceInvaders/View/SFMLBatchedEntityRepresentation.hpp>
+#include <SpaceInvaders/View/SFMLBunkerRepresentation.hpp>
+#include <SpaceInvaders/View/SFMLSnapshotEntityRepresentation.hpp>
+#include <SpaceInvaders/View/TextureCache.hpp>
 #include <SpaceInvaders/Model/Entities.hpp>
+#include <SpaceInvaders/Profiler.hpp>
 
 namespace Game
 {
@@ -32,46 +39,81 @@ namespace Game
     {
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-        SFMLView::SFMLView(GameState gameState, unsigned int score) :
-            m_window   {sf::VideoMode{800, 600}, "Space Invaders"},
-            m_gameState{gameState}
+        SFMLView::SFMLView(GameState gameState, unsigned int score, RenderMode renderMode, sf::Time tickTime) :
+            m_window    {sf::VideoMode{800, 600}, "Space Invaders"},
+            m_gameState {gameState},
+            m_renderMode{renderMode},
+            m_vertices  {sf::Quads},
+            m_tickTime  {tickTime},
+            m_images    {std::make_shared<std::vector<std::string>>()}
         {
             // Load the font
             if (!m_font.loadFromFile("Resources/DejaVuSans.ttf"))
                 throw std::runtime_error("Failed to load the font 'Resources/DejaVuSans.ttf'.");
 
             // Load the background
-            if (!m_backgroundTexture.loadFromFile("Resources/Background.png"))
-                throw std::runtime_error("Failed to load 'Resources/Background.png'.");
+            m_backgroundTexture = TextureCache::getTexture("Resources/Background.png");
 
-            m_backgroundSprite.setTexture(m_backgroundTexture);
-            m_backgroundSprite.setScale(static_cast<float>(SCREEN_WIDTH) / m_backgroundTexture.getSize().x,
-                                        static_cast<float>(SCREEN_HEIGHT) / m_backgroundTexture.getSize().y);
+            m_backgroundSprite.setTexture(*m_backgroundTexture);
+            m_backgroundSprite.setScale(static_cast<float>(SCREEN_WIDTH) / m_backgroundTexture->getSize().x,
+                                        static_cast<float>(SCREEN_HEIGHT) / m_backgroundTexture->getSize().y);
 
-            m_score.setFont(m_font);
-            m_lives.setFont(m_font);
-            m_message.setFont(m_font);
+            // Pack the images of the entities in the texture atlas, other images will be added when they are needed
+            for (auto& filename : {"Resources/Bullet.png", "Resources/Enemy1.png", "Resources/Enemy2.png",
+                                   "Resources/Enemy3.png", "Resources/Player.png", "Resources/Wall.png"})
+            {
+                m_atlas.addImage(filename);
+
+                if (m_renderMode == RenderMode::Threaded)
+                    getImageId(filename);
+            }
 
-            m_score.setCharacterSize(30);
-            m_lives.setCharacterSize(30);
-            m_message.setCharacterSize(30);
+            m_hud = std::unique_ptr<Hud>(new Hud{m_font, score});
+            m_hudState.score = score;
 
-            m_score.setPosition(10, 0);
-            m_score.setString("0");
+            m_profilerText.setFont(m_font);
+            m_profilerText.setCharacterSize(14);
+            m_profilerText.setPosition(15, 45);
+            m_profilerBackground.setPosition(10, 40);
+            m_profilerBackground.setFillColor(sf::Color{0, 0, 0, 180});
 
             // Change the game state when the signal gets send
-            addObserver([this](const Event& e){ m_gameState = e.gameState; }, Event::Type::GameStateChanged);
+            addObserver([this](const Event& e){ m_gameState = e.gameState; m_sceneChanged = true; }, Event::Type::GameStateChanged);
 
-            Event scoreEvent{Event::Type::ScoreChanged};
-            scoreEvent.score = score;
-            scoreChanged(scoreEvent);
+            // From now on only the render thread may use the window for drawing
+            if (m_renderMode == RenderMode::Threaded)
+            {
+                m_window.setActive(false);
+                m_rendering = true;
+                m_renderThread = std::thread{&SFMLView::render, this};
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        SFMLView::~SFMLView()
+        {
+            stopRenderThread();
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         void SFMLView::addEntity(const EntityPtr entity)
         {
-            m_entities.push_back(std::unique_ptr<AbstractEntityRepresentation>(new SFMLEntityRepresentation(m_window, entity)));
+            const BunkerPtr bunker = std::dynamic_pointer_cast<Model::BunkerEntity>(entity);
+
+            if (bunker)
+                m_entities.push_back(std::unique_ptr<AbstractEntityRepresentation>(new SFMLBunkerRepresentation(createDrawRectFunction(bunker->getImageFilename()), bunker)));
+            else if (m_renderMode == RenderMode::Threaded)
+            {
+                const std::string& filename = entity->getImageFilename();
+                const unsigned int image = filename.empty() ? 0 : getImageId(filename);
+                m_entities.push_back(std::unique_ptr<AbstractEntityRepresentation>(new SFMLSnapshotEntityRepresentation(m_sprites, image, entity)));
+            }
+            else
+                m_entities.push_back(std::unique_ptr<AbstractEntityRepresentation>(new SFMLBatchedEntityRepresentation(m_vertices, m_atlas, entity)));
+
+            m_sceneChanged = true;
 
             entity->addObserver(std::bind(&AbstractView::entityDestroyed, this, std::placeholders::_1, m_entities.back().get()), Event::Type::Destroyed);
             entity->addObserver(std::bind(&SFMLView::scoreChanged, this, std::placeholders::_1), Event::Type::ScoreChanged);
@@ -79,19 +121,62 @@ namespace Game
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+        SFMLBunkerRepresentation::DrawRectFunction SFMLView::createDrawRectFunction(const std::string& filename)
+        {
+            if (filename.empty())
+                return [](const sf::Vector2f&, const sf::Vector2f&){};
+
+            if (m_renderMode == RenderMode::Threaded)
+            {
+                const unsigned int image = getImageId(filename);
+                return [this, image](const sf::Vector2f& position, const sf::Vector2f& size)
+                    {
+                        m_sprites.push_back(SceneSnapshot::Sprite{image, position, position, size});
+                    };
+            }
+
+            const sf::IntRect rect = m_atlas.addImage(filename);
+            const sf::FloatRect textureRect{static_cast<float>(rect.left), static_cast<float>(rect.top),
+                                            static_cast<float>(rect.width), static_cast<float>(rect.height)};
+            return [this, textureRect](const sf::Vector2f& position, const sf::Vector2f& size)
+                {
+                    const float textureRight = textureRect.left + textureRect.width;
+                    const float textureBottom = textureRect.top + textureRect.height;
+
+                    m_vertices.append(sf::Vertex{position, sf::Vector2f{textureRect.left, textureRect.top}});
+                    m_vertices.append(sf::Vertex{sf::Vector2f{position.x + size.x, position.y}, sf::Vector2f{textureRight, textureRect.top}});
+                    m_vertices.append(sf::Vertex{position + size, sf::Vector2f{textureRight, textureBottom}});
+                    m_vertices.append(sf::Vertex{sf::Vector2f{position.x, position.y + size.y}, sf::Vector2f{textureRect.left, textureBottom}});
+                };
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
         void SFMLView::handleEvents()
         {
+            Profiler::ScopedTimer timer{Profiler::Phase::HandleEvents};
+
             sf::Event event;
             while (m_window.pollEvent(event))
             {
                 // The window can be closed at any time
                 if (event.type == sf::Event::Closed)
                 {
+                    stopRenderThread();
                     m_window.close();
                     notifyObservers(Event{Event::Type::ApplicationExit});
                     break;
                 }
 
+                // The profiler can be used in every game state
+                if (event.type == sf::Event::KeyPressed)
+                {
+                    if (event.key.code == sf::Keyboard::F3)
+                        toggleProfiler();
+                    else if (event.key.code == sf::Keyboard::F4)
+                        writeProfile();
+                }
+
                 // Most events are only used when playing the game
                 if (m_gameState == GameState::Playing)
                 {
@@ -157,7 +242,7 @@ namespace Game
                             break;
                         case GameState::GameOver:
                             event.gameState = GameState::MainMenu;
-                            m_score.setString("0");
+                            m_hudState.score = 0;
                             break;
                     };
 
@@ -170,117 +255,320 @@ namespace Game
 
         void SFMLView::draw()
         {
+            if (m_renderMode == RenderMode::Threaded)
+            {
+                if (m_sceneChanged)
+                    publishSnapshot();
+
+                return;
+            }
+
+            Profiler::ScopedTimer timer{Profiler::Phase::Draw};
+
             m_window.clear();
             m_window.draw(m_backgroundSprite);
 
-            switch (m_gameState)
+            // The entities stay visible behind the pause screen
+            if ((m_gameState == GameState::Playing) || (m_gameState == GameState::Paused))
+                drawEntities();
+
+            drawOverlays(m_gameState, m_hudState, m_showProfiler);
+
+            m_window.display();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLView::drawEntities()
+        {
+            m_vertices.clear();
+            for (auto& entity : m_entities)
+                entity->draw(m_interpolation);
+
+            m_window.draw(m_vertices, sf::RenderStates{&m_atlas.getTexture()});
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLView::drawOverlays(GameState gameState, const HudState& hudState, bool showProfiler)
+        {
+            // The hud only rebuilds the texts of which the value differs from what it showed before
+            m_hud->setScore(hudState.score);
+            if (hudState.livesVisible)
+                m_hud->setLives(hudState.lives);
+            else
+                m_hud->hideLives();
+            m_hud->setMessage(hudState.message);
+
+            m_hud->draw(m_window, gameState);
+
+            // The text is cleared so that the overlay doesn't show old timings when it is shown again
+            if (showProfiler)
+                drawProfiler();
+            else if (!m_profilerText.getString().isEmpty())
+                m_profilerText.setString("");
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLView::publishSnapshot()
+        {
+            m_sceneChanged = false;
+
+            // The representations add their sprite to m_sprites, which is then swapped with the sprites of
+            // the write buffer. The vectors keep being reused, so they only allocate while the scene grows.
+            m_sprites.clear();
+            if ((m_gameState == GameState::Playing) || (m_gameState == GameState::Paused))
             {
-                case GameState::MainMenu:
-                {
-                    sf::Text header("Space Invaders", m_font, 72);
-                    sf::Text instruction("[ Press return key to start playing ]", m_font, 24);
+                for (auto& entity : m_entities)
+                    entity->draw(m_interpolation);
+            }
 
-                    header.setColor(sf::Color::Green);
-                    instruction.setColor(sf::Color::Yellow);
+            SceneSnapshot& snapshot = m_snapshots.getWriteBuffer();
+            snapshot.sprites.swap(m_sprites);
+            snapshot.images = m_images;
+            snapshot.gameState = m_gameState;
+            snapshot.hud = m_hudState;
+            snapshot.showProfiler = m_showProfiler;
+            snapshot.interpolation = m_interpolation;
+            snapshot.tickTime = m_tickTime.asSeconds();
+            snapshot.publishTime = std::chrono::steady_clock::now();
+
+            m_snapshots.publish();
+        }
 
-                    header.setPosition((m_window.getSize().x / 2.0f) - (header.getLocalBounds().width / 2.0f),
-                                       (m_window.getSize().y / 3.0f) - (header.getLocalBounds().height / 2.0f));
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-                    instruction.setPosition((m_window.getSize().x / 2.0f) - (instruction.getLocalBounds().width / 2.0f),
-                                            (m_window.getSize().y * 2.0f / 3.0f) - (instruction.getLocalBounds().height / 2.0f));
+        void SFMLView::render()
+        {
+            m_window.setActive(true);
 
-                    m_window.draw(header);
-                    m_window.draw(instruction);
+            while (m_rendering)
+            {
+                // Keep drawing the last snapshot when no new one was published, the entities keep moving
+                // because the interpolation depends on the time that passed since it was published
+                m_snapshots.fetch();
 
-                    break;
-                }
-                case GameState::Paused:
-                {
-                    for (auto& entity : m_entities)
-                        entity->draw();
+                const SceneSnapshot& snapshot = m_snapshots.getReadBuffer();
+                if (snapshot.images)
+                    drawSnapshot(snapshot);
 
-                    m_window.draw(m_score);
-                    m_window.draw(m_lives);
+                sf::sleep(sf::milliseconds(1));
+            }
 
-                    sf::Text header("Paused", m_font, 64);
-                    sf::Text instruction("[ Press return key to continue ]", m_font, 24);
+            m_window.setActive(false);
+        }
 
-                    header.setPosition((m_window.getSize().x / 2.0f) - (header.getLocalBounds().width / 2.0f),
-                                       (m_window.getSize().y / 3.0f) - (header.getLocalBounds().height / 2.0f));
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-                    instruction.setPosition((m_window.getSize().x / 2.0f) - (instruction.getLocalBounds().width / 2.0f),
-                                            (m_window.getSize().y * 2.0f / 3.0f) - (instruction.getLocalBounds().height / 2.0f));
+        void SFMLView::drawSnapshot(const SceneSnapshot& snapshot)
+        {
+            Profiler::ScopedTimer timer{Profiler::Phase::Draw};
 
-                    m_window.draw(header);
-                    m_window.draw(instruction);
+            // Images that were used for the first time are added to the atlas here, where the window is active
+            const std::vector<std::string>& images = *snapshot.images;
+            while (m_imageRects.size() < images.size())
+            {
+                const sf::IntRect rect = m_atlas.addImage(images[m_imageRects.size()]);
+                m_imageRects.push_back(sf::FloatRect{static_cast<float>(rect.left), static_cast<float>(rect.top),
+                                                     static_cast<float>(rect.width), static_cast<float>(rect.height)});
+            }
 
-                    break;
+            m_window.clear();
+            m_window.draw(m_backgroundSprite);
+
+            if ((snapshot.gameState == GameState::Playing) || (snapshot.gameState == GameState::Paused))
+            {
+                float interpolation = snapshot.interpolation;
+                if ((snapshot.gameState == GameState::Playing) && (snapshot.tickTime > 0))
+                {
+                    const std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - snapshot.publishTime;
+                    interpolation = std::min(interpolation + (elapsed.count() / snapshot.tickTime), 1.0f);
                 }
-                case GameState::Playing:
+
+                m_vertices.clear();
+                for (const auto& sprite : snapshot.sprites)
                 {
-                    for (auto& entity : m_entities)
-                        entity->draw();
+                    const sf::FloatRect& textureRect = m_imageRects[sprite.image];
 
-                    m_window.draw(m_score);
-                    m_window.draw(m_lives);
-                    m_window.draw(m_message);
+                    const float left = sprite.previousPosition.x + ((sprite.currentPosition.x - sprite.previousPosition.x) * interpolation);
+                    const float top = sprite.previousPosition.y + ((sprite.currentPosition.y - sprite.previousPosition.y) * interpolation);
 
-                    break;
+                    const float right = left + sprite.size.x;
+                    const float bottom = top + sprite.size.y;
+
+                    const float textureRight = textureRect.left + textureRect.width;
+                    const float textureBottom = textureRect.top + textureRect.height;
+
+                    m_vertices.append(sf::Vertex{sf::Vector2f{left, top}, sf::Vector2f{textureRect.left, textureRect.top}});
+                    m_vertices.append(sf::Vertex{sf::Vector2f{right, top}, sf::Vector2f{textureRight, textureRect.top}});
+                    m_vertices.append(sf::Vertex{sf::Vector2f{right, bottom}, sf::Vector2f{textureRight, textureBottom}});
+                    m_vertices.append(sf::Vertex{sf::Vector2f{left, bottom}, sf::Vector2f{textureRect.left, textureBottom}});
                 }
-                case GameState::GameOver:
-                {
-                    sf::Text header("Game Over", m_font, 64);
-                    sf::Text score(m_score.getString(), m_font, 42);
-                    sf::Text instruction("[ Press return key to continue ]", m_font, 24);
 
-                    header.setPosition((m_window.getSize().x / 2.0f) - (header.getLocalBounds().width / 2.0f),
-                                       (m_window.getSize().y / 3.0f) - (header.getLocalBounds().height / 2.0f));
+                m_window.draw(m_vertices, sf::RenderStates{&m_atlas.getTexture()});
+            }
+
+            drawOverlays(snapshot.gameState, snapshot.hud, snapshot.showProfiler);
+
+            m_window.display();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-                    score.setPosition((m_window.getSize().x / 2.0f) - (score.getLocalBounds().width / 2.0f),
-                                      (m_window.getSize().y / 2.0f) - (score.getLocalBounds().height / 2.0f));
+        void SFMLView::stopRenderThread()
+        {
+            if (!m_renderThread.joinable())
+                return;
 
-                    instruction.setPosition((m_window.getSize().x / 2.0f) - (instruction.getLocalBounds().width / 2.0f),
-                                            (m_window.getSize().y * 2.0f / 3.0f) - (instruction.getLocalBounds().height / 2.0f));
+            m_rendering = false;
+            m_renderThread.join();
+        }
 
-                    m_window.draw(header);
-                    m_window.draw(score);
-                    m_window.draw(instruction);
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-                    break;
+        unsigned int SFMLView::getImageId(const std::string& filename)
+        {
+            auto it = m_imageIds.find(filename);
+            if (it != m_imageIds.end())
+                return it->second;
+
+            // Snapshots that were already published keep pointing to the old list, so it is copied
+            auto images = std::make_shared<std::vector<std::string>>(*m_images);
+            images->push_back(filename);
+            m_images = images;
+
+            const unsigned int image = static_cast<unsigned int>(images->size() - 1);
+            m_imageIds[filename] = image;
+            return image;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLView::drawProfiler()
+        {
+            if (m_profilerText.getString().isEmpty() || (m_profilerClock.getElapsedTime() > sf::milliseconds(500)))
+            {
+                m_profilerClock.restart();
+
+                std::ostringstream text;
+                text << std::fixed << std::setprecision(1);
+                text << std::left << std::setw(16) << "Phase (us)" << std::right
+                     << std::setw(8) << "min" << std::setw(8) << "avg" << std::setw(8) << "p99";
+
+                for (std::size_t i = 0; i < static_cast<std::size_t>(Profiler::Phase::Count); ++i)
+                {
+                    const auto phase = static_cast<Profiler::Phase>(i);
+                    const Profiler::Statistics statistics = Profiler::getStatistics(phase);
+
+                    text << '\n' << std::left << std::setw(16) << Profiler::getPhaseName(phase) << std::right
+                         << std::setw(8) << statistics.min << std::setw(8) << statistics.average << std::setw(8) << statistics.p99;
                 }
+
+                m_profilerText.setString(text.str());
+                m_profilerBackground.setSize(sf::Vector2f{m_profilerText.getLocalBounds().width + 10,
+                                                          m_profilerText.getLocalBounds().height + 15});
             }
 
-            m_window.display();
+            m_window.draw(m_profilerBackground);
+            m_window.draw(m_profilerText);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLView::toggleProfiler()
+        {
+            m_showProfiler = !m_showProfiler;
+            m_sceneChanged = true;
+
+            // Start with fresh timings every time the overlay is shown
+            if (m_showProfiler)
+            {
+                Profiler::clear();
+                Profiler::setEnabled(true);
+            }
+            else if (!m_measuringProfile)
+                Profiler::setEnabled(false);
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLView::writeProfile()
+        {
+            // There is nothing to write when the timings weren't being measured yet
+            if (!Profiler::isEnabled())
+            {
+                Profiler::clear();
+                Profiler::setEnabled(true);
+                m_measuringProfile = true;
+
+                setMessage("Measuring, press F4 again to write Profile.csv");
+                return;
+            }
+
+            try
+            {
+                Profiler::writeCsv("Profile.csv");
+                setMessage("Timings written to Profile.csv");
+            }
+            catch (const std::runtime_error& e)
+            {
+                setMessage(e.what());
+            }
+
+            m_measuringProfile = false;
+            if (!m_showProfiler)
+                Profiler::setEnabled(false);
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         void SFMLView::setMessage(const std::string& message)
         {
-            m_message.setString(message);
-            m_message.setPosition(sf::Vector2f{(SCREEN_WIDTH - m_message.getLocalBounds().width) / 2.0f, 0});
+            m_hudState.message = message;
+            m_sceneChanged = true;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         void SFMLView::removeMessage()
         {
-            m_message.setString("");
+            m_hudState.message.clear();
+            m_sceneChanged = true;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void SFMLView::resetScene(GameState gameState, unsigned int score)
+        {
+            AbstractView::resetScene(gameState, score);
+
+            // The vertices belong to the render thread when there is one
+            if (m_renderMode != RenderMode::Threaded)
+                m_vertices.clear();
+
+            m_gameState = gameState;
+
+            m_hudState.score = score;
+            m_hudState.livesVisible = false;
+            removeMessage();
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         void SFMLView::scoreChanged(const Event& event)
         {
-            m_score.setString(std::to_string(std::stoi(m_score.getString().toAnsiString()) + event.score));
+            m_hudState.score += event.score;
+            m_sceneChanged = true;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
 
         void SFMLView::updateLives(unsigned int lives)
         {
-            m_lives.setString("Lives: " + std::to_string(lives));
-            m_lives.setPosition(SCREEN_WIDTH - m_lives.getLocalBounds().width - 10, 0);
+            m_hudState.lives = lives;
+            m_hudState.livesVisible = true;
+            m_sceneChanged = true;
         }
 
         ////////////////////////////////////////////////////////////////////////////////////////////////////
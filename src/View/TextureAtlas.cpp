@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <algorithm>
+#include <SpaceInvaders/View/TextureAtlas.hpp>
+
+namespace Game
+{
+    namespace View
+    {
+        namespace
+        {
+            // A new row is started when an image doesn't fit in this width
+            const unsigned int ATLAS_SHELF_WIDTH = 1024;
+
+            // Transparent pixels between the images, so that they don't bleed into each other when scaled
+            const unsigned int ATLAS_PADDING = 1;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        sf::IntRect TextureAtlas::addImage(const std::string& filename)
+        {
+            auto it = m_imageRects.find(filename);
+            if (it != m_imageRects.end())
+                return it->second;
+
+            sf::Image image;
+            if (!image.loadFromFile(filename))
+                throw std::runtime_error("Failed to add '" + filename + "' to the texture atlas.");
+
+            // Start a new shelf when the image doesn't fit on the current one
+            if ((m_shelfLeft > 0) && (m_shelfLeft + image.getSize().x > ATLAS_SHELF_WIDTH))
+            {
+                m_shelfTop += m_shelfHeight + ATLAS_PADDING;
+                m_shelfLeft = 0;
+                m_shelfHeight = 0;
+            }
+
+            sf::IntRect rect{static_cast<int>(m_shelfLeft), static_cast<int>(m_shelfTop),
+                             static_cast<int>(image.getSize().x), static_cast<int>(image.getSize().y)};
+
+            m_shelfLeft += image.getSize().x + ATLAS_PADDING;
+            m_shelfHeight = std::max(m_shelfHeight, image.getSize().y);
+
+            // Make the atlas image larger when needed, the images that were already in it keep their place
+            sf::Vector2u atlasSize{std::max(m_image.getSize().x, m_shelfLeft), std::max(m_image.getSize().y, m_shelfTop + m_shelfHeight)};
+            if ((atlasSize.x != m_image.getSize().x) || (atlasSize.y != m_image.getSize().y))
+            {
+                sf::Image newImage;
+                newImage.create(atlasSize.x, atlasSize.y, sf::Color::Transparent);
+
+                if ((m_image.getSize().x > 0) && (m_image.getSize().y > 0))
+                    newImage.copy(m_image, 0, 0);
+
+                m_image = newImage;
+            }
+
+            m_image.copy(image, rect.left, rect.top);
+
+            if (!m_texture.loadFromImage(m_image))
+                throw std::runtime_error("Failed to create the texture atlas.");
+
+            m_imageRects[filename] = rect;
+            return rect;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        const sf::Texture& TextureAtlas::getTexture() const
+        {
+            return m_texture;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (C) 2013 Bruno Van de Velde (vdv_b@tgui.eu)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+
+#include <map>
+#include <mutex>
+#include <SpaceInvaders/View/TextureCache.hpp>
+
+namespace Game
+{
+    namespace View
+    {
+        namespace
+        {
+            std::mutex& getMutex()
+            {
+                static std::mutex mutex;
+                return mutex;
+            }
+
+            std::map<std::string, std::shared_ptr<sf::Texture>>& getTextures()
+            {
+                static std::map<std::string, std::shared_ptr<sf::Texture>> textures;
+                return textures;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::shared_ptr<const sf::Texture> TextureCache::getTexture(const std::string& filename)
+        {
+            std::lock_guard<std::mutex> lock(getMutex());
+
+            auto& texture = getTextures()[filename];
+            if (texture == nullptr)
+            {
+                auto newTexture = std::make_shared<sf::Texture>();
+                if (!newTexture->loadFromFile(filename))
+                {
+                    getTextures().erase(filename);
+                    throw std::runtime_error("Failed to load '" + filename + "'.");
+                }
+
+                texture = newTexture;
+            }
+
+            return texture;
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        void TextureCache::removeUnusedTextures()
+        {
+            std::lock_guard<std::mutex> lock(getMutex());
+
+            auto& textures = getTextures();
+            for (auto it = textures.begin(); it != textures.end();)
+            {
+                if (it->second.use_count() == 1)
+                    it = textures.erase(it);
+                else
+                    ++it;
+            }
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+        std::size_t TextureCache::getTextureCount()
+        {
+            std::lock_guard<std::mutex> lock(getMutex());
+            return getTextures().size();
+        }
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////
+    }
+}
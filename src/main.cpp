@@ -22,16 +22,49 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
+#include <algorithm>
 #include <iostream>
+#include <string>
 #include <SpaceInvaders/Client.hpp>
+#include <SpaceInvaders/Factory/StressEntityFactory.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int main()
+int main(int argc, char* argv[])
 {
     try
     {
-        Game::Client client;
+        // The options can be placed anywhere, the other arguments are positional
+        std::vector<std::string> arguments{argv + 1, argv + argc};
+        std::vector<std::string> levelOptions;
+        Game::EntityFactoryCreator createFactory = Game::StressEntityFactory::parseArguments(arguments, &levelOptions);
+
+        bool renderThread = false;
+        auto option = std::find(arguments.begin(), arguments.end(), "--render-thread");
+        if (option != arguments.end())
+        {
+            renderThread = true;
+            arguments.erase(option);
+        }
+
+        if (arguments.size() > 2)
+        {
+            std::cout << "Usage: " << argv[0] << " [seed] [recording file] [--stress enemies walls bullets] [--render-thread]" << std::endl;
+            return 1;
+        }
+
+        // A game can be played again by passing the seed that was printed
+        std::uint64_t seed = Game::Random::createSeed();
+        if ((arguments.size() > 0) && (arguments[0] != "random"))
+            seed = std::stoull(arguments[0]);
+
+        std::string recordingFilename;
+        if (arguments.size() > 1)
+            recordingFilename = arguments[1];
+
+        std::cout << "Seed: " << seed << std::endl;
+
+        Game::Client client{seed, Game::TICKS_PER_SECOND, recordingFilename, createFactory, renderThread, levelOptions};
         client.mainLoop();
         return 0;
     }